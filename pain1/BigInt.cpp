@@ -2,8 +2,31 @@
 #include <iostream>
 #include <cctype>
 #include <algorithm>
+#include <locale>
+#include <stdexcept>
+#include <vector>
+#include "BigIntKernels.h"
 #include "Logger.h"
 
+//========== Limb Helpers ==========
+
+namespace {
+    using Limb = BigInt::Limb;
+
+    // Digits BigInt::read() buffers and converts at a time
+    const std::size_t INPUT_CHUNK_DIGITS = std::size_t(1) << 16;
+
+    /**
+     * @brief Drops zero limbs from the most significant end.
+     * @param v The limb vector to normalise.
+     */
+    void trim(LimbVector &v) {
+        while (!v.empty() && v.back() == 0) {
+            v.pop_back();
+        }
+    }
+}
+
 //========== Constructors ==========
 
 
@@ -13,43 +36,75 @@ Logger bigIntLogger(LogLevel::Debug, "bigint_operations.log");
 /**
  * @brief Default constructor initializing BigInt to zero.
  */
-BigInt::BigInt() : number("0"), isNegative(false) {}
+BigInt::BigInt() : isNegative(false) {}
 
 /**
  * @brief Integer constructor initializing BigInt with an integer value.
  * @param num Integer value to initialize BigInt.
  */
-BigInt::BigInt(int num) : number(std::to_string(std::abs(num))), isNegative(num < 0) {}
+BigInt::BigInt(int num) : isNegative(false) {
+    assignScalar(scalarMagnitude(num), num < 0);
+}
+
+/**
+ * @brief Integer constructors for the remaining built-in widths.
+ * @param num Integer value to initialize BigInt.
+ */
+BigInt::BigInt(long num) : isNegative(false) {
+    assignScalar(scalarMagnitude(num), num < 0);
+}
+
+BigInt::BigInt(long long num) : isNegative(false) {
+    assignScalar(scalarMagnitude(num), num < 0);
+}
+
+BigInt::BigInt(unsigned int num) : isNegative(false) {
+    assignScalar(num, false);
+}
+
+BigInt::BigInt(unsigned long num) : isNegative(false) {
+    assignScalar(num, false);
+}
+
+BigInt::BigInt(unsigned long long num) : isNegative(false) {
+    assignScalar(num, false);
+}
+
+BigInt::BigInt(__int128 num) : isNegative(false) {
+    // Negate in unsigned arithmetic so the most negative value stays well defined
+    unsigned __int128 magnitude = static_cast<unsigned __int128>(num);
+    assignScalar(num < 0 ? 0 - magnitude : magnitude, num < 0);
+}
+
+BigInt::BigInt(unsigned __int128 num) : isNegative(false) {
+    assignScalar(num, false);
+}
 
 /**
  * @brief String constructor initializing BigInt from a string representation.
  * @param num String representation of an integer.
  * @throws std::invalid_argument If the string is not a valid integer representation.
  */
-BigInt::BigInt(const std::string &num) {
-    if (num.empty()) {
-        number = "0";
-        isNegative = false;
-    } else {
+BigInt::BigInt(const std::string &num) : isNegative(false) {
+    if (!num.empty()) {
         // Determine if the number is negative and store the corresponding boolean value
         isNegative = num[0] == '-';
-        // Extract the numeric part of the string, excluding any sign
-        number = isNegative ? num.substr(1) : num;
+        // Skip the sign when validating and converting the digits
+        size_t start = isNegative ? 1 : 0;
 
         // Check if the number string is a valid representation
-        if (!isValid(number)) {
+        if (!isValid(num)) {
             bigIntLogger.log("Invalid string argument provided to constructor.", LogLevel::Error);
             throw std::invalid_argument("Invalid BigInt initialization string: " + num);
-        } else {
-            // Remove any leading zeros to normalize the representation
-            removeLeadingZeros();
-
-            // After removing leading zeros, adjust for cases like "-0" or "0"
-            if (number.empty() || number == "0") {
-                number = "0";
-                isNegative = false;
-            }
         }
+
+        // Convert the digits by recursive splitting, see bigint_kernels::fromDecimal
+        size_t digits = num.size() - start;
+        limbs.resize(digits / 19 + 1);
+        limbs.resize(bigint_kernels::fromDecimal(limbs.data(), num.data() + start, digits));
+
+        // Normalize the representation, which also turns "-0" into "0"
+        removeLeadingZeros();
     }
 }
 
@@ -59,13 +114,14 @@ BigInt::BigInt(const std::string &num) {
  * @brief Copy constructor.
  * @param other BigInt instance to copy.
  */
-BigInt::BigInt(const BigInt &other) : number(other.number), isNegative(other.isNegative) {}
+BigInt::BigInt(const BigInt &other) : limbs(other.limbs), isNegative(other.isNegative) {}
 
 /**
  * @brief Move constructor.
  * @param other BigInt instance to move from.
  */
-BigInt::BigInt(BigInt &&other) noexcept: number(std::move(other.number)), isNegative(other.isNegative) {
+BigInt::BigInt(BigInt &&other) noexcept: limbs(std::move(other.limbs)), isNegative(other.isNegative) {
+    other.limbs.clear();
     other.isNegative = false;  // Reset the moved-from object to a default state
 }
 
@@ -87,7 +143,7 @@ BigInt::~BigInt() {
  */
 BigInt &BigInt::operator=(const BigInt &other) {
     if (this != &other) {  // Protect against self-assignment
-        number = other.number;
+        limbs = other.limbs;
         isNegative = other.isNegative;
     }
     return *this;
@@ -100,8 +156,9 @@ BigInt &BigInt::operator=(const BigInt &other) {
  */
 BigInt &BigInt::operator=(BigInt &&other) noexcept {
     if (this != &other) {  // Protect against self-assignment
-        number = std::move(other.number);
+        limbs = std::move(other.limbs);
         isNegative = other.isNegative;
+        other.limbs.clear();
         other.isNegative = false;  // Reset the moved-from object to a default state
     }
     return *this;
@@ -110,20 +167,238 @@ BigInt &BigInt::operator=(BigInt &&other) noexcept {
 //========== Private Methods ==========
 
 /**
- * @brief Removes leading zeros from the number string.
+ * @brief Replaces the value with the product of two BigInts, either of which may be
+ *        the current instance.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return Reference to the current instance.
  */
-void BigInt::removeLeadingZeros() {
-    size_t firstNotZero = number.find_first_not_of('0');
-    if (firstNotZero != std::string::npos) {
-        number = number.substr(firstNotZero);
+BigInt &BigInt::assignProduct(const BigInt &a, const BigInt &b) {
+    // Edge Case: Multiplying by 0
+    if (a.isZero() || b.isZero()) {
+        limbs.clear();
+        isNegative = false;
+        return *this;
+    }
+
+    // Determine the sign of the result
+    bool negative = a.isNegative != b.isNegative;
+
+    if (a.limbs.size() == 1 && b.limbs.size() == 1) {
+        // Word-sized operands: one native 64x64 -> 128-bit multiplication
+        assignScalar(static_cast<unsigned __int128>(a.limbs[0]) * b.limbs[0], false);
+    } else if (this == &a || this == &b) {
+        // The factors are still being read, so the product needs a buffer of its own
+        limbs = &a == &b ? squareMagnitude(a.limbs) : multiplyMagnitudes(a.limbs, b.limbs);
     } else {
-        number = "0";
+        // Write straight into the current limbs, reusing their buffer when it is large enough
+        size_t an = a.limbs.size();
+        size_t bn = b.limbs.size();
+        limbs.resize(an + bn);
+        if (&a == &b || a.limbs == b.limbs) {
+            // a * a (the same object or an equal magnitude) takes the cheaper squaring path
+            bigint_kernels::square(limbs.data(), a.limbs.data(), an);
+        } else {
+            // Perform multiplication with the kernel matching the operand sizes
+            bigint_kernels::multiply(limbs.data(), a.limbs.data(), an, b.limbs.data(), bn);
+        }
+        trim(limbs);
     }
-    if (number == "0") {
+
+    isNegative = negative;
+    return *this;
+}
+
+/**
+ * @brief Adds or subtracts a * b in place.
+ *
+ * Short products are accumulated one row of the shorter factor at a time with the
+ * single-limb kernels. When the signs make it a subtraction that overshoots, the limbs
+ * end up holding B^n - |result|, which a final two's complement negation corrects.
+ * Long products, and factors aliasing the destination, go through a temporary.
+ *
+ * @param a The first factor.
+ * @param b The second factor.
+ * @param subtract Whether to subtract the product instead of adding it.
+ * @return Reference to the current instance.
+ */
+BigInt &BigInt::accumulateProduct(const BigInt &a, const BigInt &b, bool subtract) {
+    if (a.isZero() || b.isZero()) {
+        return *this;
+    }
+    bool productNegative = (a.isNegative != b.isNegative) != subtract;
+    const LimbVector &longer = a.limbs.size() >= b.limbs.size() ? a.limbs : b.limbs;
+    const LimbVector &shorter = a.limbs.size() >= b.limbs.size() ? b.limbs : a.limbs;
+
+    if (this == &a || this == &b || shorter.size() >= bigint_kernels::KARATSUBA_THRESHOLD) {
+        BigInt product;
+        product.assignProduct(a, b);
+        product.isNegative = productNegative;
+        return *this += product;
+    }
+
+    if (isZero()) {
+        isNegative = productNegative;
+    }
+    size_t n = std::max(limbs.size(), longer.size() + shorter.size()) + 1;
+    limbs.resize(n, 0);
+    Limb *r = limbs.data();
+
+    if (isNegative == productNegative) {  // Same sign: the magnitude grows, and fits in n limbs
+        for (size_t j = 0; j < shorter.size(); ++j) {
+            Limb carry = bigint_kernels::addMultiply1(r + j, longer.data(), longer.size(), shorter[j]);
+            for (size_t i = j + longer.size(); carry != 0; ++i) {
+                r[i] += carry;
+                carry = r[i] < carry ? 1 : 0;
+            }
+        }
+    } else {  // Opposite signs: subtract, noting whether the result crosses zero
+        bool crossed = false;
+        for (size_t j = 0; j < shorter.size(); ++j) {
+            Limb borrow = bigint_kernels::subtractMultiply1(r + j, longer.data(), longer.size(), shorter[j]);
+            for (size_t i = j + longer.size(); borrow != 0 && i < n; ++i) {
+                Limb limb = r[i];
+                r[i] = limb - borrow;
+                borrow = limb < borrow ? 1 : 0;
+            }
+            crossed = crossed || borrow != 0;
+        }
+        if (crossed) {
+            // r = B^n - |result|, so negate it and take the product's sign
+            Limb carry = 1;
+            for (size_t i = 0; i < n; ++i) {
+                r[i] = ~r[i] + carry;
+                carry = (carry != 0 && r[i] == 0) ? 1 : 0;
+            }
+            isNegative = productNegative;
+        }
+    }
+
+    removeLeadingZeros();
+    return *this;
+}
+
+/**
+ * @brief Replaces the value with a signed scalar of up to 128 bits.
+ * @param magnitude The absolute value.
+ * @param negative Whether the value is negative.
+ */
+void BigInt::assignScalar(unsigned __int128 magnitude, bool negative) {
+    limbs.clear();
+    while (magnitude != 0) {
+        limbs.push_back(static_cast<Limb>(magnitude));
+        magnitude >>= 64;
+    }
+    isNegative = negative;
+    removeLeadingZeros();
+}
+
+/**
+ * @brief Adds a signed single-limb value in place; carries and borrows stop as soon as
+ *        they are absorbed.
+ * @param magnitude The absolute value to add.
+ * @param negative Whether the value to add is negative.
+ * @return Reference to the current instance.
+ */
+BigInt &BigInt::addScalar(Limb magnitude, bool negative) {
+    if (magnitude == 0) {
+        return *this;
+    }
+    if (limbs.empty()) {
+        limbs.push_back(magnitude);
+        isNegative = negative;
+    } else if (isNegative == negative) {  // Same sign: the magnitude grows
+        Limb carry = magnitude;
+        for (size_t i = 0; carry != 0 && i < limbs.size(); ++i) {
+            limbs[i] += carry;
+            carry = limbs[i] < carry ? 1 : 0;
+        }
+        if (carry != 0) {
+            limbs.push_back(carry);
+        }
+    } else if (limbs.size() > 1 || limbs[0] >= magnitude) {  // Opposite sign, |this| >= |value|
+        Limb borrow = magnitude;
+        for (size_t i = 0; borrow != 0; ++i) {
+            Limb limb = limbs[i];
+            limbs[i] = limb - borrow;
+            borrow = limb < borrow ? 1 : 0;
+        }
+        removeLeadingZeros();
+    } else {  // Opposite sign, |this| < |value|: the sign flips
+        limbs[0] = magnitude - limbs[0];
+        isNegative = negative;
+    }
+    return *this;
+}
+
+/**
+ * @brief Multiplies by a signed single-limb value in place.
+ * @param magnitude The absolute value of the multiplier.
+ * @param negative Whether the multiplier is negative.
+ * @return Reference to the current instance.
+ */
+BigInt &BigInt::multiplyScalar(Limb magnitude, bool negative) {
+    Limb carry = bigint_kernels::multiply1(limbs.data(), limbs.data(), limbs.size(), magnitude);
+    if (carry != 0) {
+        limbs.push_back(carry);
+    }
+    isNegative = isNegative != negative;
+    removeLeadingZeros();
+    return *this;
+}
+
+/**
+ * @brief Divides by a signed single-limb value in place, truncating toward zero.
+ * @param magnitude The absolute value of the divisor.
+ * @param negative Whether the divisor is negative.
+ * @return Reference to the current instance.
+ * @throws std::runtime_error If the divisor is zero.
+ */
+BigInt &BigInt::divideScalar(Limb magnitude, bool negative) {
+    if (magnitude == 0) {
+        throw std::runtime_error("Division by zero");
+    }
+    bigint_kernels::divide1(limbs.data(), limbs.data(), limbs.size(), magnitude);
+    isNegative = isNegative != negative;
+    removeLeadingZeros();
+    return *this;
+}
+
+/**
+ * @brief Replaces the value with its remainder modulo a single-limb value; the result
+ *        keeps the sign of the dividend.
+ * @param magnitude The absolute value of the divisor.
+ * @return Reference to the current instance.
+ * @throws std::runtime_error If the divisor is zero.
+ */
+BigInt &BigInt::remainderScalar(Limb magnitude) {
+    if (magnitude == 0) {
+        throw std::runtime_error("Division by zero");
+    }
+    Limb remainder = bigint_kernels::remainder1(limbs.data(), limbs.size(), magnitude);
+    limbs.assign(1, remainder);
+    removeLeadingZeros();
+    return *this;
+}
+
+/**
+ * @brief Removes leading zero limbs and clears the sign of zero.
+ */
+void BigInt::removeLeadingZeros() {
+    trim(limbs);
+    if (limbs.empty()) {
         isNegative = false;
     }
 }
 
+/**
+ * @brief Checks whether the BigInt is zero.
+ * @return True if the value is zero, otherwise false.
+ */
+bool BigInt::isZero() const {
+    return limbs.empty();
+}
+
 //========== Input/Output Stream Overloads ==========
 
 /**
@@ -133,10 +408,7 @@ void BigInt::removeLeadingZeros() {
  * @return Reference to the output stream.
  */
 std::ostream &operator<<(std::ostream &out, const BigInt &bigInt) {
-    if (bigInt.isNegative) {  // If BigInt is negative, output a negative sign
-        out << '-';
-    }
-    out << bigInt.number;  // Output the number part
+    out << bigInt.toString();  // Convert to decimal, including the sign
     return out;  // Return the output stream
 }
 
@@ -147,10 +419,135 @@ std::ostream &operator<<(std::ostream &out, const BigInt &bigInt) {
  * @return Reference to the input stream.
  */
 std::istream &operator>>(std::istream &in, BigInt &b) {
-    std::string input;
-    in >> input;  // Read input into a string
-    b = BigInt(input);  // Convert the string to BigInt and store it
-    return in;  // Return the input stream
+    return BigInt::read(in, b);  // Stream the digits in chunks, with no digit cap
+}
+
+/**
+ * @brief Reads a decimal number from a stream in fixed-size chunks.
+ *
+ * Digits are taken straight from the stream buffer, INPUT_CHUNK_DIGITS at a time, and
+ * each full chunk is converted to limbs at once. Converted chunks are kept like the
+ * digits of a binary counter: two neighbours covering the same number of digits are
+ * merged as high * 10^digits + low, so every merge multiplies operands of equal size,
+ * as in the recursive conversion of the constructor. 10^d is applied as 5^d and a
+ * shift by d bits, since 5^d is 30% shorter. Besides the value, memory holds one chunk
+ * of text and the powers 5^(chunk * 2^k), which together are about the size of the
+ * result.
+ *
+ * @param in The stream; leading whitespace is skipped as for other formatted input.
+ * @param b Receives the value; unchanged if nothing could be read.
+ * @param maxDigits Largest number of digits accepted, leading zeros included.
+ * @return Reference to the stream; failbit is set if it held no number.
+ * @throws std::invalid_argument If the token is not a number or has more than
+ *         maxDigits digits, even when the stream throws on failbit; failbit is set
+ *         as well.
+ */
+std::istream &BigInt::read(std::istream &in, BigInt &b, std::size_t maxDigits) {
+    std::istream::sentry sentry(in);
+    if (!sentry) {
+        return in;
+    }
+    std::streambuf *buffer = in.rdbuf();
+    const std::locale locale = in.getloc();
+    using Traits = std::char_traits<char>;
+
+    std::vector<BigInt> pieces;  // Most significant first
+    std::vector<std::size_t> levels;  // pieces[i] holds INPUT_CHUNK_DIGITS * 2^levels[i] digits
+    std::vector<BigInt> powers;  // powers[k] = 5^(INPUT_CHUNK_DIGITS * 2^k)
+    auto power = [&powers](std::size_t level) -> const BigInt & {
+        while (powers.size() <= level) {
+            powers.push_back(powers.empty() ? BigInt(5).pow(static_cast<int>(INPUT_CHUNK_DIGITS))
+                                            : powers.back().square());
+        }
+        return powers[level];
+    };
+    auto convert = [](const char *digits, std::size_t n) {
+        BigInt value;
+        value.limbs.resize(n / 19 + 1);
+        value.limbs.resize(bigint_kernels::fromDecimal(value.limbs.data(), digits, n));
+        value.removeLeadingZeros();
+        return value;
+    };
+    auto reject = [&in](const std::string &message) {
+        bigIntLogger.log(message, LogLevel::Error);
+        try {
+            in.setstate(std::ios::failbit);
+        } catch (const std::ios_base::failure &) {
+            // The stream's own exception must not replace the documented one
+        }
+        throw std::invalid_argument(message);
+    };
+
+    std::vector<char> chunk(INPUT_CHUNK_DIGITS);
+    std::size_t filled = 0;
+    std::size_t total = 0;
+    int c = buffer->sgetc();
+    bool negative = c == '-';
+    if (negative) {
+        c = buffer->snextc();
+    }
+    while (true) {
+        if (Traits::eq_int_type(c, Traits::eof())) {
+            in.setstate(std::ios::eofbit);
+            break;
+        }
+        char digit = Traits::to_char_type(c);
+        if (digit < '0' || digit > '9') {
+            if (std::isspace(digit, locale)) {
+                break;
+            }
+            reject("Invalid character in BigInt input.");
+        }
+        if (total == maxDigits) {
+            reject("BigInt input exceeds " + std::to_string(maxDigits) + " digits.");
+        }
+        chunk[filled++] = digit;
+        ++total;
+        if (filled == INPUT_CHUNK_DIGITS) {
+            pieces.push_back(convert(chunk.data(), filled));
+            levels.push_back(0);
+            filled = 0;
+            // Merge equal neighbours, like carries in a binary counter
+            while (levels.size() >= 2 && levels[levels.size() - 2] == levels.back()) {
+                BigInt low = std::move(pieces.back());
+                pieces.pop_back();
+                levels.pop_back();
+                pieces.back() *= power(levels.back());
+                pieces.back() <<= INPUT_CHUNK_DIGITS << levels.back();
+                pieces.back() += low;
+                ++levels.back();
+            }
+        }
+        c = buffer->snextc();
+    }
+
+    if (total == 0) {
+        if (negative) {
+            reject("Invalid character in BigInt input.");
+        }
+        in.setstate(std::ios::failbit);
+        return in;
+    }
+
+    // Fold the pieces in from the least significant end, so the partial products grow;
+    // the scale 10^digits so far is kept as 5^digits and a shift
+    BigInt result = convert(chunk.data(), filled);
+    BigInt scale = BigInt(5).pow(static_cast<int>(filled));
+    std::size_t shift = filled;
+    while (!pieces.empty()) {
+        BigInt term = pieces.back() * scale;
+        result += term <<= shift;
+        pieces.pop_back();
+        if (!pieces.empty()) {
+            scale *= power(levels.back());
+            shift += INPUT_CHUNK_DIGITS << levels.back();
+        }
+        levels.pop_back();
+    }
+    result.isNegative = negative;
+    result.removeLeadingZeros();
+    b = std::move(result);
+    return in;
 }
 
 //========== Arithmetic Operators ==========
@@ -160,36 +557,58 @@ std::istream &operator>>(std::istream &in, BigInt &b) {
  * @param other The BigInt to add.
  * @return The result of the addition.
  */
-BigInt BigInt::operator+(const BigInt &other) const {
-    bigIntLogger.log("Adding two BigInts.", LogLevel::Debug);
-    BigInt result;  // To store the result
-    if (isNegative == other.isNegative) {  // If both BigInts have the same sign
-        result.number = addStrings(number, other.number);
-        result.isNegative = isNegative;
-    } else {  // If BigInts have different signs
-        if (isSmaller(number, other.number)) {
-            result.number = subtractStrings(other.number, number);
-            result.isNegative = other.isNegative;
-        } else {
-            result.number = subtractStrings(number, other.number);
-            result.isNegative = isNegative;
-        }
-    }
-
-    // Handle -0 edge case
-    if (result.number == "0") {
-        result.isNegative = false;
-    }
+BigInt BigInt::operator+(const BigInt &other) const & {
+    BigInt result = *this;  // Start from a copy and add in place
+    result += other;
     return result;
 }
 
+/**
+ * @brief Addition operator for a temporary left operand; reuses its limbs.
+ * @param other The BigInt to add.
+ * @return The result of the addition.
+ */
+BigInt BigInt::operator+(const BigInt &other) && {
+    *this += other;
+    return std::move(*this);
+}
+
+/**
+ * @brief Addition operator for a temporary right operand; reuses its limbs.
+ * @param other The BigInt to add.
+ * @return The result of the addition.
+ */
+BigInt BigInt::operator+(BigInt &&other) const & {
+    other += *this;  // Addition commutes
+    return std::move(other);
+}
+
+/**
+ * @brief Addition operator for two temporaries; reuses the left operand's limbs.
+ * @param other The BigInt to add.
+ * @return The result of the addition.
+ */
+BigInt BigInt::operator+(BigInt &&other) && {
+    return std::move(*this) + static_cast<const BigInt &>(other);
+}
+
 /**
  * @brief Addition assignment operator for BigInt.
  * @param other The BigInt to add.
  * @return The current instance after addition.
  */
 BigInt &BigInt::operator+=(const BigInt &other) {
-    *this = *this + other;  // Use operator+ to perform addition
+    if (isNegative == other.isNegative) {  // Same sign: magnitudes add up
+        addMagnitudeInPlace(limbs, other.limbs);
+    } else if (compareMagnitudes(limbs, other.limbs) >= 0) {  // Different signs, |this| >= |other|
+        subtractMagnitudeInPlace(limbs, other.limbs);
+    } else {  // Different signs, |this| < |other|: the result takes the sign of other
+        reverseSubtractMagnitudeInPlace(limbs, other.limbs);
+        isNegative = other.isNegative;
+    }
+
+    // Handle -0 edge case
+    removeLeadingZeros();
     return *this;
 }
 
@@ -198,49 +617,58 @@ BigInt &BigInt::operator+=(const BigInt &other) {
  * @param other The BigInt to subtract.
  * @return The result of the subtraction.
  */
-BigInt BigInt::operator-(const BigInt &other) const {
-    bigIntLogger.log("Subtracting two BigInts.", LogLevel::Debug);
-    BigInt result;  // To store the result
-    // Handle various cases based on the signs of the BigInts
-    if (isNegative && other.isNegative) {
-        // -a - (-b) = b - a
-        if (isSmaller(number, other.number)) {
-            result.number = subtractStrings(other.number, number);
-        } else {
-            result.number = subtractStrings(number, other.number);
-            result.isNegative = true;
-        }
-    } else if (!isNegative && other.isNegative) {
-        // a - (-b) = a + b
-        result.number = addStrings(number, other.number);
-    } else if (isNegative && !other.isNegative) {
-        // -a - b = -(a + b)
-        result.number = addStrings(number, other.number);
-        result.isNegative = true;
-    } else {
-        // a - b
-        if (isSmaller(number, other.number)) {
-            result.number = subtractStrings(other.number, number);
-            result.isNegative = true;
-        } else {
-            result.number = subtractStrings(number, other.number);
-        }
-    }
-
-    // Handle -0 edge case
-    if (result.number == "0") {
-        result.isNegative = false;
-    }
+BigInt BigInt::operator-(const BigInt &other) const & {
+    BigInt result = *this;  // Start from a copy and subtract in place
+    result -= other;
     return result;
 }
 
+/**
+ * @brief Subtraction operator for a temporary left operand; reuses its limbs.
+ * @param other The BigInt to subtract.
+ * @return The result of the subtraction.
+ */
+BigInt BigInt::operator-(const BigInt &other) && {
+    *this -= other;
+    return std::move(*this);
+}
+
+/**
+ * @brief Subtraction operator for a temporary right operand; reuses its limbs.
+ * @param other The BigInt to subtract.
+ * @return The result of the subtraction.
+ */
+BigInt BigInt::operator-(BigInt &&other) const & {
+    other -= *this;  // a - b = -(b - a)
+    return -std::move(other);
+}
+
+/**
+ * @brief Subtraction operator for two temporaries; reuses the left operand's limbs.
+ * @param other The BigInt to subtract.
+ * @return The result of the subtraction.
+ */
+BigInt BigInt::operator-(BigInt &&other) && {
+    return std::move(*this) - static_cast<const BigInt &>(other);
+}
+
 /**
  * @brief Subtraction assignment operator for BigInt.
  * @param other The BigInt to subtract.
  * @return The current instance after subtraction.
  */
 BigInt &BigInt::operator-=(const BigInt &other) {
-    *this = *this - other;  // Use operator- to perform subtraction
+    if (isNegative != other.isNegative) {  // a - (-b) = a + b and -a - b = -(a + b)
+        addMagnitudeInPlace(limbs, other.limbs);
+    } else if (compareMagnitudes(limbs, other.limbs) >= 0) {  // Same sign, |this| >= |other|
+        subtractMagnitudeInPlace(limbs, other.limbs);
+    } else {  // Same sign, |this| < |other|: the sign flips
+        reverseSubtractMagnitudeInPlace(limbs, other.limbs);
+        isNegative = !isNegative;
+    }
+
+    // Handle -0 edge case
+    removeLeadingZeros();
     return *this;
 }
 
@@ -256,13 +684,24 @@ BigInt BigInt::operator+() const {
  * @brief Unary minus operator for BigInt.
  * @return The negated BigInt.
  */
-BigInt BigInt::operator-() const {
+BigInt BigInt::operator-() const & {
     BigInt result = *this;  // Make a copy of the current instance
-    if (result.number != "0") {  // Check to ensure we don't negate zero
+    if (!result.isZero()) {  // Check to ensure we don't negate zero
         result.isNegative = !result.isNegative;  // Flip the sign
     }
     return result;
 }
+
+/**
+ * @brief Unary minus operator for a temporary; flips the sign in place.
+ * @return The negated BigInt.
+ */
+BigInt BigInt::operator-() && {
+    if (!isZero()) {  // Check to ensure we don't negate zero
+        isNegative = !isNegative;
+    }
+    return std::move(*this);
+}
 //========== Increment and Decrement Operators ==========
 
 /**
@@ -270,8 +709,7 @@ BigInt BigInt::operator-() const {
  * @return Reference to the current instance after incrementing.
  */
 BigInt &BigInt::operator++() {
-    *this += 1;  // Add one to the current BigInt
-    return *this;  // Return the current instance
+    return addScalar(1, false);  // Add one to the limbs in place
 }
 
 /**
@@ -289,8 +727,7 @@ BigInt BigInt::operator++(int) {
  * @return Reference to the current instance after decrementing.
  */
 BigInt &BigInt::operator--() {
-    *this -= 1;  // Subtract one from the current BigInt
-    return *this;  // Return the current instance
+    return addScalar(1, true);  // Subtract one from the limbs in place
 }
 
 /**
@@ -310,84 +747,95 @@ BigInt BigInt::operator--(int) {
  * @param other The BigInt to multiply with.
  * @return The result of the multiplication.
  */
-BigInt BigInt::operator*(const BigInt &other) const {
-    // Edge Case: Multiplying by 0
-    if (this->number == "0" || other.number == "0") {
-        return BigInt();  // Return 0
-    }
-
-    BigInt result;
-    // Perform multiplication using the Karatsuba algorithm
-    result.number = karatsubaMultiply(BigInt(this->number), BigInt(other.number));
-
-    // Determine the sign of the result
-    result.isNegative = this->isNegative != other.isNegative;
-
+BigInt BigInt::operator*(const BigInt &other) const & {
+    BigInt result;  // The product needs a fresh buffer anyway, so skip copying *this
+    result.assignProduct(*this, other);
     return result;
 }
 
 /**
- * @brief Multiplication assignment operator for BigInt.
+ * @brief Multiplication operator for a temporary left operand.
  * @param other The BigInt to multiply with.
- * @return Reference to the current instance after multiplication.
+ * @return The result of the multiplication.
  */
-BigInt &BigInt::operator*=(const BigInt &other) {
-    *this = *this * other;  // Use operator* to perform multiplication
-    return *this;
+BigInt BigInt::operator*(const BigInt &other) && {
+    *this *= other;
+    return std::move(*this);
 }
 
-//========== Division and Remainder Operators ==========
+/**
+ * @brief Multiplication operator for a temporary right operand.
+ * @param other The BigInt to multiply with.
+ * @return The result of the multiplication.
+ */
+BigInt BigInt::operator*(BigInt &&other) const & {
+    other *= *this;  // Multiplication commutes
+    return std::move(other);
+}
 
 /**
- * @brief Division operator for BigInt with integer divisor.
- * @param other The integer to divide by.
- * @return The result of the division.
+ * @brief Multiplication operator for two temporaries.
+ * @param other The BigInt to multiply with.
+ * @return The result of the multiplication.
  */
-BigInt BigInt::operator/(int other) const {
-    return *this / BigInt(other);  // Convert int to BigInt and perform division
+BigInt BigInt::operator*(BigInt &&other) && {
+    *this *= other;
+    return std::move(*this);
 }
 
 /**
- * @brief Division assignment operator for BigInt with integer divisor.
- * @param other The integer to divide by.
- * @return Reference to the current instance after division.
+ * @brief Multiplication assignment operator for BigInt.
+ * @param other The BigInt to multiply with.
+ * @return Reference to the current instance after multiplication.
  */
-BigInt &BigInt::operator/=(int other) {
-    *this = *this / BigInt(other);  // Convert int to BigInt and perform division
-    return *this;
+BigInt &BigInt::operator*=(const BigInt &other) {
+    return assignProduct(*this, other);
 }
 
 /**
- * @brief Remainder operator for BigInt with integer divisor.
- * @param other The integer to divide by.
- * @return The remainder after division.
+ * @brief Adds a * b to the BigInt without building the product when it is short.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return Reference to the current instance.
  */
-BigInt BigInt::operator%(int other) const {
-    return *this % BigInt(other);  // Convert int to BigInt and perform remainder operation
+BigInt &BigInt::addProduct(const BigInt &a, const BigInt &b) {
+    return accumulateProduct(a, b, false);
 }
 
 /**
- * @brief Remainder assignment operator for BigInt with integer divisor.
- * @param other The integer to divide by.
- * @return Reference to the current instance after calculating the remainder.
+ * @brief Subtracts a * b from the BigInt without building the product when it is short.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return Reference to the current instance.
  */
-BigInt &BigInt::operator%=(int other) {
-    *this = *this % BigInt(other);  // Convert int to BigInt and perform remainder operation
-    return *this;
+BigInt &BigInt::subtractProduct(const BigInt &a, const BigInt &b) {
+    return accumulateProduct(a, b, true);
 }
 
+//========== Division and Remainder Operators ==========
+
 /**
  * @brief Division operator for BigInt.
  * @param other The BigInt to divide by.
  * @return The result of the division.
  */
-BigInt BigInt::operator/(const BigInt &other) const {
+BigInt BigInt::operator/(const BigInt &other) const & {
     if (other == 0) {
         throw std::runtime_error("Division by zero");  // Division by zero is undefined
     }
     return divide(other).first;  // Perform division and return the quotient
 }
 
+/**
+ * @brief Division operator for a temporary left operand.
+ * @param other The BigInt to divide by.
+ * @return The result of the division.
+ */
+BigInt BigInt::operator/(const BigInt &other) && {
+    *this /= other;
+    return std::move(*this);
+}
+
 /**
  * @brief Division assignment operator for BigInt.
  * @param other The BigInt to divide by.
@@ -406,13 +854,23 @@ BigInt &BigInt::operator/=(const BigInt &other) {
  * @param other The BigInt to divide by.
  * @return The remainder after division.
  */
-BigInt BigInt::operator%(const BigInt &other) const {
+BigInt BigInt::operator%(const BigInt &other) const & {
     if (other == 0) {
         throw std::runtime_error("Division by zero");  // Division by zero is undefined
     }
     return divide(other).second;  // Perform division and return the remainder
 }
 
+/**
+ * @brief Remainder operator for a temporary left operand.
+ * @param other The BigInt to divide by.
+ * @return The remainder after division.
+ */
+BigInt BigInt::operator%(const BigInt &other) && {
+    *this %= other;
+    return std::move(*this);
+}
+
 /**
  * @brief Remainder assignment operator for BigInt.
  * @param other The BigInt to divide by.
@@ -434,7 +892,7 @@ BigInt &BigInt::operator%=(const BigInt &other) {
  * @return True if both BigInts are equal, otherwise false.
  */
 bool BigInt::operator==(const BigInt &other) const {
-    return (this->isNegative == other.isNegative) && (this->number == other.number);
+    return (this->isNegative == other.isNegative) && (this->limbs == other.limbs);
 }
 
 /**
@@ -457,11 +915,8 @@ bool BigInt::operator<(const BigInt &other) const {
 
     bool bothAreNegative = this->isNegative && other.isNegative;
 
-    if (this->number.length() != other.number.length()) {
-        return (this->number.length() < other.number.length()) != bothAreNegative;
-    }
-
-    return (this->number < other.number) != bothAreNegative;
+    int comparison = compareMagnitudes(this->limbs, other.limbs);
+    return bothAreNegative ? comparison > 0 : comparison < 0;
 }
 
 /**
@@ -491,6 +946,295 @@ bool BigInt::operator>=(const BigInt &other) const {
     return (*this > other) || (*this == other);
 }
 
+//========== Bitwise Operators ==========
+
+/**
+ * @brief Left shift operator; multiplies by 2^bits.
+ * @param bits Number of bits to shift by.
+ * @return The shifted BigInt.
+ */
+BigInt BigInt::operator<<(size_t bits) const & {
+    BigInt result = *this;
+    result <<= bits;
+    return result;
+}
+
+/**
+ * @brief Left shift operator for a temporary; shifts its limbs in place.
+ * @param bits Number of bits to shift by.
+ * @return The shifted BigInt.
+ */
+BigInt BigInt::operator<<(size_t bits) && {
+    *this <<= bits;
+    return std::move(*this);
+}
+
+/**
+ * @brief Right shift operator; divides by 2^bits rounding toward negative infinity.
+ * @param bits Number of bits to shift by.
+ * @return The shifted BigInt.
+ */
+BigInt BigInt::operator>>(size_t bits) const & {
+    BigInt result = *this;
+    result >>= bits;
+    return result;
+}
+
+/**
+ * @brief Right shift operator for a temporary; shifts its limbs in place.
+ * @param bits Number of bits to shift by.
+ * @return The shifted BigInt.
+ */
+BigInt BigInt::operator>>(size_t bits) && {
+    *this >>= bits;
+    return std::move(*this);
+}
+
+/**
+ * @brief Left shift assignment; the sign is kept and only the magnitude moves.
+ * @param bits Number of bits to shift by.
+ * @return Reference to the current instance.
+ */
+BigInt &BigInt::operator<<=(size_t bits) {
+    if (limbs.empty()) {
+        return *this;
+    }
+    size_t size = limbs.size();
+    size_t limbShift = bits / 64;
+    limbs.resize(size + limbShift + 1);
+    Limb *data = limbs.data();
+    if (bits % 64 != 0) {
+        data[size] = bigint_kernels::shiftLeft(data, data, size, static_cast<unsigned>(bits % 64));
+    }
+    if (limbShift > 0) {
+        std::copy_backward(data, data + size + 1, data + size + 1 + limbShift);
+        std::fill(data, data + limbShift, 0);
+    }
+    removeLeadingZeros();
+    return *this;
+}
+
+/**
+ * @brief Right shift assignment. Negative values round toward negative infinity, as an
+ *        arithmetic shift of their two's complement would.
+ * @param bits Number of bits to shift by.
+ * @return Reference to the current instance.
+ */
+BigInt &BigInt::operator>>=(size_t bits) {
+    size_t limbShift = bits / 64;
+    unsigned bitShift = static_cast<unsigned>(bits % 64);
+    bool negative = isNegative;
+    bool inexact = false;  // Whether a negative value loses set bits
+    if (negative) {
+        for (size_t i = 0; i < limbShift && i < limbs.size() && !inexact; ++i) {
+            inexact = limbs[i] != 0;
+        }
+        if (!inexact && limbShift < limbs.size() && bitShift > 0) {
+            inexact = (limbs[limbShift] << (64 - bitShift)) != 0;
+        }
+    }
+    if (limbShift >= limbs.size()) {
+        limbs.clear();
+    } else {
+        size_t size = limbs.size() - limbShift;
+        bigint_kernels::shiftRight(limbs.data(), limbs.data() + limbShift, size, bitShift);
+        limbs.resize(size);
+    }
+    removeLeadingZeros();
+    if (inexact) {
+        addScalar(1, true);  // Step down to the floor; also turns a vanished value into -1
+    }
+    return *this;
+}
+
+/**
+ * @brief Combines the two's complements of both operands limb by limb. Negative operands
+ *        and the result are converted on the fly, so no temporary copies are made.
+ * @param other The right operand; may be the BigInt itself.
+ * @param op The limb operation; applied to the sign words as well, it gives the sign.
+ * @return Reference to the current instance.
+ */
+template <typename Op>
+BigInt &BigInt::applyBitwise(const BigInt &other, Op op) {
+    bool negativeA = isNegative;
+    bool negativeB = other.isNegative;
+    bool negative = op(negativeA ? ~Limb(0) : 0, negativeB ? ~Limb(0) : 0) != 0;
+    size_t otherSize = other.limbs.size();
+    size_t size = std::max(limbs.size(), otherSize);
+    limbs.resize(size);
+    const Limb *b = other.limbs.data();  // Read after the resize, in case of aliasing
+    Limb carryA = 1;
+    Limb carryB = 1;
+    Limb carryResult = 1;
+    for (size_t i = 0; i < size; ++i) {
+        Limb x = limbs[i];
+        if (negativeA) {
+            x = ~x + carryA;
+            carryA &= x == 0;
+        }
+        Limb y = i < otherSize ? b[i] : 0;
+        if (negativeB) {
+            y = ~y + carryB;
+            carryB &= y == 0;
+        }
+        Limb r = op(x, y);
+        if (negative) {
+            r = ~r + carryResult;
+            carryResult &= r == 0;
+        }
+        limbs[i] = r;
+    }
+    if (negative && carryResult) {
+        limbs.push_back(1);  // The result is -2^(64 * size)
+    }
+    isNegative = negative;
+    removeLeadingZeros();
+    return *this;
+}
+
+/**
+ * @brief Bitwise AND operator for BigInt.
+ * @param other The BigInt to combine with.
+ * @return The bitwise AND of both values.
+ */
+BigInt BigInt::operator&(const BigInt &other) const & {
+    BigInt result = *this;
+    result &= other;
+    return result;
+}
+
+/**
+ * @brief Bitwise AND operator for a temporary left operand; reuses its limbs.
+ * @param other The BigInt to combine with.
+ * @return The bitwise AND of both values.
+ */
+BigInt BigInt::operator&(const BigInt &other) && {
+    *this &= other;
+    return std::move(*this);
+}
+
+/**
+ * @brief Bitwise OR operator for BigInt.
+ * @param other The BigInt to combine with.
+ * @return The bitwise OR of both values.
+ */
+BigInt BigInt::operator|(const BigInt &other) const & {
+    BigInt result = *this;
+    result |= other;
+    return result;
+}
+
+/**
+ * @brief Bitwise OR operator for a temporary left operand; reuses its limbs.
+ * @param other The BigInt to combine with.
+ * @return The bitwise OR of both values.
+ */
+BigInt BigInt::operator|(const BigInt &other) && {
+    *this |= other;
+    return std::move(*this);
+}
+
+/**
+ * @brief Bitwise XOR operator for BigInt.
+ * @param other The BigInt to combine with.
+ * @return The bitwise XOR of both values.
+ */
+BigInt BigInt::operator^(const BigInt &other) const & {
+    BigInt result = *this;
+    result ^= other;
+    return result;
+}
+
+/**
+ * @brief Bitwise XOR operator for a temporary left operand; reuses its limbs.
+ * @param other The BigInt to combine with.
+ * @return The bitwise XOR of both values.
+ */
+BigInt BigInt::operator^(const BigInt &other) && {
+    *this ^= other;
+    return std::move(*this);
+}
+
+/**
+ * @brief Bitwise AND assignment operator for BigInt.
+ * @param other The BigInt to combine with.
+ * @return Reference to the current instance.
+ */
+BigInt &BigInt::operator&=(const BigInt &other) {
+    if (!isNegative && !other.isNegative) {
+        // Non-negative operands only need the common low limbs
+        size_t size = std::min(limbs.size(), other.limbs.size());
+        limbs.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            limbs[i] &= other.limbs[i];
+        }
+        removeLeadingZeros();
+        return *this;
+    }
+    return applyBitwise(other, [](Limb x, Limb y) { return x & y; });
+}
+
+/**
+ * @brief Bitwise OR assignment operator for BigInt.
+ * @param other The BigInt to combine with.
+ * @return Reference to the current instance.
+ */
+BigInt &BigInt::operator|=(const BigInt &other) {
+    return applyBitwise(other, [](Limb x, Limb y) { return x | y; });
+}
+
+/**
+ * @brief Bitwise XOR assignment operator for BigInt.
+ * @param other The BigInt to combine with.
+ * @return Reference to the current instance.
+ */
+BigInt &BigInt::operator^=(const BigInt &other) {
+    return applyBitwise(other, [](Limb x, Limb y) { return x ^ y; });
+}
+
+/**
+ * @brief Bitwise NOT operator; in two's complement this is -x - 1.
+ * @return The complemented BigInt.
+ */
+BigInt BigInt::operator~() const {
+    BigInt result = -*this;
+    --result;
+    return result;
+}
+
+/**
+ * @brief Number of bits in the magnitude, ignoring the sign.
+ * @return The position of the highest set bit plus one; zero for zero.
+ */
+size_t BigInt::bitLength() const {
+    if (limbs.empty()) {
+        return 0;
+    }
+    return 64 * limbs.size() - static_cast<size_t>(__builtin_clzll(limbs.back()));
+}
+
+/**
+ * @brief Reads one bit of the two's complement representation.
+ * @param index The bit position, counted from the least significant bit.
+ * @return The bit value; bits above bitLength() are set for negative values.
+ */
+bool BigInt::testBit(size_t index) const {
+    size_t limbIndex = index / 64;
+    Limb limb = limbIndex < limbs.size() ? limbs[limbIndex] : 0;
+    bool bit = (limb >> (index % 64)) & 1;
+    if (!isNegative) {
+        return bit;
+    }
+    // The two's complement ~(m - 1) matches m up to and including its lowest set bit,
+    // and is inverted above it
+    size_t lowest = 0;
+    while (limbs[lowest] == 0) {
+        ++lowest;
+    }
+    lowest = 64 * lowest + static_cast<size_t>(__builtin_ctzll(limbs[lowest]));
+    return index <= lowest ? bit : !bit;
+}
+
 //========== Private Utility Methods ==========
 
 /**
@@ -524,200 +1268,172 @@ bool BigInt::isValid(const std::string &str) const {
 }
 
 /**
- * @brief Add two strings representing non-negative integers.
- * @param a The first string.
- * @param b The second string.
- * @return The sum of the two strings.
+ * @brief Adds the second magnitude into the first one in a single carry pass.
+ * @param a The magnitude to update; may be the same vector as b.
+ * @param b The magnitude to add.
  */
-std::string BigInt::addStrings(const std::string &a, const std::string &b) const {
-    std::string result;
-    int carry = 0;
-    int i = a.size() - 1;
-    int j = b.size() - 1;
+void BigInt::addMagnitudeInPlace(LimbVector &a, const LimbVector &b) {
+    if (a.size() < b.size()) {
+        a.resize(b.size(), 0);
+    }
 
-    while (i >= 0 || j >= 0 || carry > 0) {
-        int digitA = i >= 0 ? a[i] - '0' : 0;
-        int digitB = j >= 0 ? b[j] - '0' : 0;
-        int sum = digitA + digitB + carry;
-        result = std::to_string(sum % 10) + result;
-        carry = sum / 10;
-        i--;
-        j--;
+    Limb carry = 0;
+    size_t i = 0;
+    for (; i < b.size(); ++i) {
+        Limb sum = a[i] + carry;
+        carry = sum < carry ? 1 : 0;
+        sum += b[i];
+        carry += sum < b[i] ? 1 : 0;
+        a[i] = sum;
     }
 
-    // Remove leading zeros (if any)
-    size_t startpos = result.find_first_not_of("0");
-    return startpos != std::string::npos ? result.substr(startpos) : "0";
+    // Propagate the carry only as far as it actually travels
+    for (; carry != 0 && i < a.size(); ++i) {
+        carry = ++a[i] == 0 ? 1 : 0;
+    }
+    if (carry != 0) {
+        a.push_back(carry);
+    }
 }
 
 /**
- * @brief Subtract the second string representing a non-negative integer from the first one.
- * @param a The first string.
- * @param b The second string.
- * @return The result of the subtraction.
+ * @brief Subtracts the second magnitude from the first one in a single borrow pass.
+ * @param a The magnitude to update, which must not be smaller than b.
+ * @param b The magnitude to subtract.
  */
-std::string BigInt::subtractStrings(const std::string &a, const std::string &b) const {
-    std::string result;
-    int carry = 0;
-    int i = a.size() - 1;
-    int j = b.size() - 1;
-
-    while (i >= 0 || j >= 0 || carry > 0) {
-        int digitA = i >= 0 ? a[i] - '0' : 0;
-        int digitB = j >= 0 ? b[j] - '0' : 0;
-        int sub = digitA - digitB - carry;
-        if (sub < 0) {
-            sub += 10;
-            carry = 1;
-        } else {
-            carry = 0;
-        }
-        result = std::to_string(sub) + result;
-        i--;
-        j--;
+void BigInt::subtractMagnitudeInPlace(LimbVector &a, const LimbVector &b) {
+    Limb borrow = 0;
+    size_t i = 0;
+    for (; i < b.size(); ++i) {
+        Limb digitA = a[i];
+        Limb digitB = b[i];
+        a[i] = digitA - digitB - borrow;
+        borrow = (digitA < digitB || (digitA == digitB && borrow != 0)) ? 1 : 0;
+    }
+
+    // Propagate the borrow only as far as it actually travels
+    for (; borrow != 0 && i < a.size(); ++i) {
+        borrow = a[i]-- == 0 ? 1 : 0;
     }
 
     // Remove leading zeros (if any)
-    size_t startpos = result.find_first_not_of("0");
-    return startpos != std::string::npos ? result.substr(startpos) : "0";
+    trim(a);
 }
 
 /**
- * @brief Multiply two strings representing non-negative integers.
- * @param a The first string.
- * @param b The second string.
- * @return The product of the two strings.
+ * @brief Replaces the first magnitude with the second one minus the first.
+ * @param a The magnitude to update, which must not be larger than b.
+ * @param b The magnitude to subtract from.
  */
-std::string BigInt::multiplyStrings(const std::string &a, const std::string &b) const {
-    int lenA = a.size();
-    int lenB = b.size();
-    std::string result(lenA + lenB, '0');
+void BigInt::reverseSubtractMagnitudeInPlace(LimbVector &a, const LimbVector &b) {
+    a.resize(b.size(), 0);
+
+    Limb borrow = 0;
+    for (size_t i = 0; i < b.size(); ++i) {
+        Limb digitA = a[i];
+        Limb digitB = b[i];
+        a[i] = digitB - digitA - borrow;
+        borrow = (digitB < digitA || (digitB == digitA && borrow != 0)) ? 1 : 0;
+    }
 
-    for (int i = lenA - 1; i >= 0; i--) {
-        int carry = 0;
-        for (int j = lenB - 1; j >= 0; j--) {
-            int product = (a[i] - '0') * (b[j] - '0') + carry + (result[i + j + 1] - '0');
-            carry = product / 10;
-            result[i + j + 1] = product % 10 + '0';
-        }
-        result[i] += carry;
+    // Remove leading zeros (if any)
+    trim(a);
+}
+
+/**
+ * @brief Multiply two magnitudes, using the schoolbook basecase for short operands
+ *        and Karatsuba above bigint_kernels::KARATSUBA_THRESHOLD.
+ * @param a The first magnitude.
+ * @param b The second magnitude.
+ * @return The product of the two magnitudes.
+ */
+LimbVector BigInt::multiplyMagnitudes(const LimbVector &a, const LimbVector &b) {
+    if (a.empty() || b.empty()) {
+        return {};
     }
+    LimbVector result(a.size() + b.size());
+    bigint_kernels::multiply(result.data(), a.data(), a.size(), b.data(), b.size());
 
     // Remove leading zeros
-    size_t startpos = result.find_first_not_of("0");
-    if (std::string::npos != startpos) {
-        result = result.substr(startpos);
+    trim(result);
+    return result;
+}
+
+/**
+ * @brief Square a magnitude with the squaring kernel matching its size.
+ * @param a The magnitude.
+ * @return The square of the magnitude.
+ */
+LimbVector BigInt::squareMagnitude(const LimbVector &a) {
+    if (a.empty()) {
+        return {};
     }
+    LimbVector result(2 * a.size());
+    bigint_kernels::square(result.data(), a.data(), a.size());
 
+    // Remove leading zeros
+    trim(result);
     return result;
 }
 
 /**
- * @brief Divides two BigInts.
+ * @brief Divides two BigInts, with long division or recursive division depending on size.
  * @param other The divisor.
  * @return A pair containing the quotient and remainder.
  */
 std::pair<BigInt, BigInt> BigInt::divide(const BigInt &other) const {
-    // Make copies of dividend and divisor and make them positive
-    BigInt dividend = *this;
-    dividend.isNegative = false;
-
-    BigInt divisor = other;
-    divisor.isNegative = false;
-
-    BigInt quotient;
-    BigInt remainder;
-
     // Handle division by zero
-    if (divisor == 0) {
-        throw std::runtime_error("Division by zero in divideStrings");
+    if (other.isZero()) {
+        throw std::runtime_error("Division by zero");
     }
 
-    // If dividend < divisor or dividend == 0, set remainder to dividend
-    if (dividend < divisor || dividend == 0) {
-        remainder = dividend;
-    } else if (divisor == 1) {
-        // If divisor is 1, quotient is the dividend
-        quotient = dividend;
-    } else {
-        // Perform division using subtraction
-        while (dividend >= divisor) {
-            BigInt tempDivisor = divisor;
-            BigInt tempQuotient = 1;
-
-            // Optimize division by doubling divisor until it's less than dividend
-            while (dividend >= (tempDivisor + tempDivisor)) {
-                tempDivisor += tempDivisor;
-                tempQuotient += tempQuotient;
-            }
+    BigInt quotient;
+    BigInt remainder;
 
-            // Subtract the found multiple from the dividend
-            dividend -= tempDivisor;
-            quotient += tempQuotient;
+    if (compareMagnitudes(limbs, other.limbs) < 0) {
+        // If |dividend| < |divisor|, the remainder is the dividend itself
+        remainder.limbs = limbs;
+    } else if (limbs.size() <= 2) {
+        // Both operands fit in 128 bits, so native division does it in one step
+        unsigned __int128 dividend = limbs[0];
+        unsigned __int128 divisor = other.limbs[0];
+        if (limbs.size() == 2) {
+            dividend |= static_cast<unsigned __int128>(limbs[1]) << 64;
         }
-
-        // Set the remainder
-        remainder = dividend;
+        if (other.limbs.size() == 2) {
+            divisor |= static_cast<unsigned __int128>(other.limbs[1]) << 64;
+        }
+        quotient.assignScalar(dividend / divisor, false);
+        remainder.assignScalar(dividend % divisor, false);
+    } else {
+        size_t an = limbs.size();
+        size_t dn = other.limbs.size();
+        quotient.limbs.resize(an - dn + 1);
+        remainder.limbs.resize(dn);
+        bigint_kernels::divide(quotient.limbs.data(), remainder.limbs.data(),
+                               limbs.data(), an, other.limbs.data(), dn);
     }
 
     // Set the sign for the quotient based on original signs
-    if ((this->isNegative && !other.isNegative) || (!this->isNegative && other.isNegative)) {
-        quotient.isNegative = true;
-    }
+    quotient.isNegative = this->isNegative != other.isNegative;
 
     // Remainder will always take the sign of the dividend
     remainder.isNegative = this->isNegative;
 
+    // Trim the limbs; a zero quotient or remainder must not keep a negative sign
+    quotient.removeLeadingZeros();
+    remainder.removeLeadingZeros();
+
     return std::make_pair(quotient, remainder);
 }
 
 /**
- * @brief Multiplies two BigInts using the Karatsuba algorithm.
- * @param x The first BigInt.
- * @param y The second BigInt.
- * @return The product as a string.
+ * @brief Computes the quotient and remainder in a single long division.
+ * @param other The divisor.
+ * @return A pair containing the quotient and remainder.
  */
-std::string BigInt::karatsubaMultiply(const BigInt &x, const BigInt &y) const {
-    // Convert BigInts to strings
-    std::string xStr = x.number;
-    std::string yStr = y.number;
-
-    // Base case for recursion
-    if (xStr.size() == 1 && yStr.size() == 1) {
-        int product = std::stoi(xStr) * std::stoi(yStr);
-        return std::to_string(product);
-    }
-
-    // Pad the shorter number with zeros
-    while (xStr.size() < yStr.size()) {
-        xStr = "0" + xStr;
-    }
-    while (yStr.size() < xStr.size()) {
-        yStr = "0" + yStr;
-    }
-
-    // Calculate size of the numbers
-    int n = xStr.size();
-    int mid = n / 2;
-
-    // Split the input numbers into halves
-    BigInt x1 = BigInt(xStr.substr(0, mid));
-    BigInt x0 = BigInt(xStr.substr(mid, n - mid));
-    BigInt y1 = BigInt(yStr.substr(0, mid));
-    BigInt y0 = BigInt(yStr.substr(mid, n - mid));
-
-    // 3 recursive calls to calculate the products
-    BigInt z2 = x1 * y1;  // z2 = x1 * y1
-    BigInt z0 = x0 * y0;  // z0 = x0 * y0
-    BigInt z1 = (x1 + x0) * (y1 + y0) - z2 - z0;  // z1 = (x1 + x0) * (y1 + y0) - z2 - z0
-
-    // Assemble the product from the computed pieces
-    z2.number += std::string(2 * (n - mid), '0');  // z2 * 10^(2 * mid)
-    z1.number += std::string(n - mid, '0');  // z1 * 10^mid
-
-    BigInt result = z2 + z1 + z0;  // result = z2 * 10^(2 * mid) + z1 * 10^mid + z0
-
-    return result.number;
+std::pair<BigInt, BigInt> BigInt::divmod(const BigInt &other) const {
+    return divide(other);
 }
 
 /**
@@ -732,46 +1448,184 @@ BigInt BigInt::pow(int exponent) const {
 
     BigInt result = 1;
     BigInt base = *this;
+    BigInt product;  // Receives each product, then swaps buffers with its target
 
     // Exponentiation by squaring
     while (exponent > 0) {
         // If exponent is odd, multiply the result by base
         if (exponent % 2 == 1) {
-            result *= base;
+            product.assignProduct(result, base);
+            std::swap(result, product);
         }
 
-        // Square the base
-        base *= base;
-
         // Divide exponent by 2
         exponent /= 2;
+
+        // Square the base, unless it is not needed anymore
+        if (exponent > 0) {
+            product.assignProduct(base, base);
+            std::swap(base, product);
+        }
     }
 
     return result;
 }
 
 /**
- * @brief Compares if string a is smaller than string b, treating them as numbers.
- * @param a First string.
- * @param b Second string.
- * @return True if a < b, false otherwise.
+ * @brief Squares the BigInt.
+ * @return The square, which is never negative.
  */
-bool BigInt::isSmaller(const std::string &a, const std::string &b) const {
-    int n1 = a.length(), n2 = b.length();
+BigInt BigInt::square() const {
+    BigInt result;
+    result.limbs = squareMagnitude(limbs);
+    return result;
+}
+
+//========== Roots ==========
 
-    if (n1 < n2)
+/**
+ * @brief Computes the integer square root.
+ * @return floor(sqrt(value)).
+ * @throws std::invalid_argument If the value is negative.
+ */
+BigInt BigInt::isqrt() const {
+    if (isNegative) {
+        throw std::invalid_argument("Square root of a negative BigInt is not supported");
+    }
+    return rootMagnitude(2);
+}
+
+/**
+ * @brief Computes the integer k-th root, rounded toward zero.
+ * @param k The root degree, at least 1.
+ * @return The root; negative for a negative value and odd k.
+ * @throws std::invalid_argument If k < 1, or k is even and the value negative.
+ */
+BigInt BigInt::iroot(int k) const {
+    if (k < 1) {
+        throw std::invalid_argument("Root degree must be positive");
+    }
+    if (isNegative) {
+        if (k % 2 == 0) {
+            throw std::invalid_argument("Even root of a negative BigInt is not supported");
+        }
+        return -(-*this).rootMagnitude(k);
+    }
+    return rootMagnitude(k);
+}
+
+/**
+ * @brief Checks whether the value is a perfect square.
+ *
+ * Squares take only 12 of 64 values modulo 64, 16 of 63, 21 of 65 and 6 of 11, so
+ * together the residues reject all but about 0.4% of non-squares before any root is
+ * computed. The residue modulo 45045 = 63 * 65 * 11 costs one pass over the limbs.
+ *
+ * @return True if the value is the square of an integer.
+ */
+bool BigInt::isPerfectSquare() const {
+    if (isNegative) {
+        return false;
+    }
+    if (isZero()) {
         return true;
-    if (n2 < n1)
+    }
+
+    struct ResidueTables {
+        bool mod64[64] = {};
+        bool mod63[63] = {};
+        bool mod65[65] = {};
+        bool mod11[11] = {};
+
+        ResidueTables() {
+            for (unsigned i = 0; i < 65; ++i) {
+                mod64[i * i % 64] = true;
+                mod63[i * i % 63] = true;
+                mod65[i * i % 65] = true;
+                mod11[i * i % 11] = true;
+            }
+        }
+    };
+    static const ResidueTables tables;
+
+    if (!tables.mod64[limbs[0] % 64]) {
         return false;
+    }
+    Limb residue = bigint_kernels::remainder1(limbs.data(), limbs.size(), 63 * 65 * 11);
+    if (!tables.mod63[residue % 63] || !tables.mod65[residue % 65] || !tables.mod11[residue % 11]) {
+        return false;
+    }
+    BigInt root = rootMagnitude(2);
+    return root.square() == *this;
+}
 
-    for (int i = 0; i < n1; i++) {
-        if (a[i] < b[i])
-            return true;
-        else if (a[i] > b[i])
-            return false;
+/**
+ * @brief Floor of the k-th root of the magnitude.
+ *
+ * The root of the value shifted right by k * s bits, with s about a 2k-th of its bit
+ * length, gives the top half of the bits of the result. Shifted back and rounded up it
+ * is an overestimate off by at most 2^s, so Newton's iteration, which decreases
+ * monotonically from above, reaches the floor in one or two steps: each recursion
+ * level doubles the precision with a few full-size multiplications and one division.
+ *
+ * @param k The root degree, at least 1.
+ * @return floor(|value|^(1/k)).
+ */
+BigInt BigInt::rootMagnitude(int k) const {
+    BigInt magnitude = isNegative ? -*this : *this;
+    size_t bits = bitLength();
+    size_t degree = static_cast<size_t>(k);
+    if (k == 1 || bits <= degree) {
+        // Below 2^k the root is 0 or 1
+        return k == 1 ? magnitude : BigInt(isZero() ? 0 : 1);
+    }
+
+    BigInt x;
+    size_t shift = bits / (2 * degree);
+    if (bits <= 64 || shift == 0) {
+        // 2^ceil(bits / k) is above the root
+        x = BigInt(1) << ((bits + degree - 1) / degree);
+    } else {
+        x = ((*this >> (degree * shift)).rootMagnitude(k) + 1) << shift;
+    }
+
+    if (k == 2) {
+        // One step leaves the root or the root plus one
+        x = (x + magnitude / x) >> 1;
+        if (x.square() > magnitude) {
+            --x;
+        }
+        if (bits > 64 && shift > 0) {
+            return x;
+        }
+    }
+    while (true) {
+        BigInt next = (x * (k - 1) + magnitude / x.pow(k - 1)) / k;
+        if (next >= x) {
+            return x;
+        }
+        x = std::move(next);
+    }
+}
+
+/**
+ * @brief Compares two magnitudes.
+ * @param a First magnitude.
+ * @param b Second magnitude.
+ * @return Negative if a < b, zero if a == b, positive if a > b.
+ */
+int BigInt::compareMagnitudes(const LimbVector &a, const LimbVector &b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+
+    for (size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
     }
 
-    return false;
+    return 0;
 }
 
 /**
@@ -779,11 +1633,12 @@ bool BigInt::isSmaller(const std::string &a, const std::string &b) const {
  * @return The string representation of BigInt.
  */
 std::string BigInt::toString() const {
-    if (isNegative) {
-        return "-" + number;
+    if (isZero()) {
+        return "0";
     }
-    return number;
-}
-
-
 
+    // Print into an upper bound of the digit count, then drop the padding zeros
+    std::string digits(bigint_kernels::decimalDigitsBound(limbs.size()), '0');
+    bigint_kernels::toDecimal(&digits[0], digits.size(), limbs.data(), limbs.size());
+    return (isNegative ? "-" : "") + digits.substr(digits.find_first_not_of('0'));
+}
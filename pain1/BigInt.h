@@ -1,14 +1,33 @@
 #ifndef BIGINT_H
 #define BIGINT_H
 
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include "LimbVector.h"
 
 /**
  * @brief A class to represent large integers (beyond built-in data types range).
  */
 class BigInt {
 public:
+    /**
+     * @brief One machine word of the magnitude; values are stored in base 2^64.
+     */
+    using Limb = std::uint64_t;
+
+    /**
+     * @brief Enables the scalar operator templates for built-in integer types that fit in
+     *        a limb. GNU dialects count __int128 as integral; it goes through the
+     *        BigInt(__int128) constructors instead.
+     */
+    template <typename T>
+    using EnableIfScalar =
+        typename std::enable_if<std::is_integral<T>::value && sizeof(T) <= sizeof(Limb), int>::type;
+
     //=================== Constructors ===================
     /**
      * @brief Default constructor that initializes the BigInt to zero.
@@ -21,6 +40,25 @@ public:
      */
     BigInt(int num);
 
+    /**
+     * @brief Constructors from the other built-in integer widths, including the full
+     *        range of the signed types.
+     * @param num An integer to initialize the BigInt with.
+     */
+    BigInt(long num);
+
+    BigInt(long long num);
+
+    BigInt(unsigned int num);
+
+    BigInt(unsigned long num);
+
+    BigInt(unsigned long long num);
+
+    BigInt(__int128 num);
+
+    BigInt(unsigned __int128 num);
+
     /**
      * @brief Constructor that initializes the BigInt with a string representation of an integer.
      * @param num A string representation of an integer.
@@ -62,11 +100,32 @@ public:
     BigInt &operator=(BigInt &&other) noexcept;
 
     //=================== Arithmetic Operators ===================
-    BigInt operator+(const BigInt &other) const;
+    // The compound assignments do the work. The binary operators copy the left operand
+    // and apply them, while the overloads taking a temporary reuse its limb buffer, so a
+    // chain such as a + b - c * d allocates only where a result outgrows its buffer.
+    BigInt operator+(const BigInt &other) const &;
 
-    BigInt operator-(const BigInt &other) const;
+    BigInt operator+(const BigInt &other) &&;
 
-    BigInt operator*(const BigInt &other) const;
+    BigInt operator+(BigInt &&other) const &;
+
+    BigInt operator+(BigInt &&other) &&;
+
+    BigInt operator-(const BigInt &other) const &;
+
+    BigInt operator-(const BigInt &other) &&;
+
+    BigInt operator-(BigInt &&other) const &;
+
+    BigInt operator-(BigInt &&other) &&;
+
+    BigInt operator*(const BigInt &other) const &;
+
+    BigInt operator*(const BigInt &other) &&;
+
+    BigInt operator*(BigInt &&other) const &;
+
+    BigInt operator*(BigInt &&other) &&;
 
     BigInt &operator+=(const BigInt &other);
 
@@ -75,18 +134,36 @@ public:
     BigInt &operator*=(const BigInt &other);
 
     //=================== Division and Remainder Operators ===================
-    BigInt operator/(const BigInt &other) const;
+    BigInt operator/(const BigInt &other) const &;
+
+    BigInt operator/(const BigInt &other) &&;
 
-    BigInt operator%(const BigInt &other) const;
+    BigInt operator%(const BigInt &other) const &;
+
+    BigInt operator%(const BigInt &other) &&;
 
     BigInt &operator/=(const BigInt &other);
 
     BigInt &operator%=(const BigInt &other);
 
+    /**
+     * @brief Computes the quotient and remainder in a single long division.
+     *
+     * The quotient is truncated toward zero and the remainder takes the sign of the
+     * dividend, matching operator/ and operator%.
+     *
+     * @param other The divisor.
+     * @return The pair (quotient, remainder).
+     * @throws std::runtime_error If the divisor is zero.
+     */
+    std::pair<BigInt, BigInt> divmod(const BigInt &other) const;
+
     //=================== Unary Operators ===================
     BigInt operator+() const;
 
-    BigInt operator-() const;
+    BigInt operator-() const &;
+
+    BigInt operator-() &&;
 
     //=================== Increment and Decrement Operators ===================
     BigInt &operator++();    // Prefix
@@ -107,17 +184,186 @@ public:
 
     bool operator>=(const BigInt &other) const;
 
-    //=================== Additional Operations ===================
-    BigInt operator/(int other) const;
+    //=================== Bitwise Operators ===================
+    // Negative values behave as infinite two's complement, so x >> k is floor(x / 2^k),
+    // ~x is -x - 1 and -1 has every bit set. Shifts work on whole limbs in O(n).
+    BigInt operator<<(size_t bits) const &;
+
+    BigInt operator<<(size_t bits) &&;
+
+    BigInt operator>>(size_t bits) const &;
+
+    BigInt operator>>(size_t bits) &&;
+
+    BigInt &operator<<=(size_t bits);
+
+    BigInt &operator>>=(size_t bits);
+
+    BigInt operator&(const BigInt &other) const &;
+
+    BigInt operator&(const BigInt &other) &&;
+
+    BigInt operator|(const BigInt &other) const &;
+
+    BigInt operator|(const BigInt &other) &&;
+
+    BigInt operator^(const BigInt &other) const &;
+
+    BigInt operator^(const BigInt &other) &&;
+
+    BigInt &operator&=(const BigInt &other);
+
+    BigInt &operator|=(const BigInt &other);
+
+    BigInt &operator^=(const BigInt &other);
+
+    BigInt operator~() const;
+
+    /**
+     * @brief Number of bits in the magnitude, ignoring the sign.
+     * @return The position of the highest set bit plus one; zero for zero.
+     */
+    size_t bitLength() const;
+
+    /**
+     * @brief Reads one bit of the two's complement representation.
+     * @param index The bit position, counted from the least significant bit.
+     * @return The bit value; bits above bitLength() are set for negative values.
+     */
+    bool testBit(size_t index) const;
+
+    //=================== Scalar Operations ===================
+    // Built-in integer operands are applied directly to the limbs, without building a
+    // temporary BigInt; division and remainder make a single pass over the dividend.
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator+(T other) const &;
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator+(T other) &&;
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator-(T other) const &;
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator-(T other) &&;
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator*(T other) const &;
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator*(T other) &&;
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator/(T other) const &;
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator/(T other) &&;
 
-    BigInt &operator/=(int other);
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator%(T other) const &;
 
-    BigInt operator%(int other) const;
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt operator%(T other) &&;
 
-    BigInt &operator%=(int other);
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt &operator+=(T other);
 
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt &operator-=(T other);
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt &operator*=(T other);
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt &operator/=(T other);
+
+    template <typename T, EnableIfScalar<T> = 0>
+    BigInt &operator%=(T other);
+
+    //=================== Fused Operations ===================
+    /**
+     * @brief Adds a * b to the BigInt. Below the Karatsuba threshold the product is
+     *        accumulated row by row straight into the limbs, without a temporary.
+     * @param a The first factor; may be the BigInt itself.
+     * @param b The second factor; may be the BigInt itself.
+     * @return A reference to the updated BigInt.
+     */
+    BigInt &addProduct(const BigInt &a, const BigInt &b);
+
+    /**
+     * @brief Subtracts a * b from the BigInt, fused the same way as addProduct().
+     * @param a The first factor; may be the BigInt itself.
+     * @param b The second factor; may be the BigInt itself.
+     * @return A reference to the updated BigInt.
+     */
+    BigInt &subtractProduct(const BigInt &a, const BigInt &b);
+
+    //=================== Additional Operations ===================
     BigInt pow(int exponent) const;
 
+    /**
+     * @brief Squares the BigInt using the dedicated squaring kernels.
+     * @return The value multiplied by itself.
+     */
+    BigInt square() const;
+
+    //=================== Roots ===================
+    /**
+     * @brief Integer square root by Newton iteration with precision doubling.
+     * @return floor(sqrt(value)).
+     * @throws std::invalid_argument If the value is negative.
+     */
+    BigInt isqrt() const;
+
+    /**
+     * @brief Integer k-th root by Newton iteration with precision doubling.
+     * @param k The root degree, at least 1.
+     * @return The root rounded toward zero; negative values have odd-degree roots only.
+     * @throws std::invalid_argument If k < 1, or k is even and the value negative.
+     */
+    BigInt iroot(int k) const;
+
+    /**
+     * @brief Checks whether the value is the square of an integer. Most non-squares are
+     *        rejected by their residues modulo 64, 63, 65 and 11 without a root.
+     * @return True for 0, 1, 4, 9, ...; false for negative values.
+     */
+    bool isPerfectSquare() const;
+
+    //=================== Combinatorics ===================
+    // Implemented in BigIntCombinatorics.cpp. Large products are formed by balanced
+    // product trees, whose branches run on the BigIntThreadPool while it is running.
+    /**
+     * @brief n! from its prime factorisation: the odd primes are grouped by the bits of
+     *        their exponents and combined by repeated squaring, the power of two is a shift.
+     * @param n The argument.
+     * @return n!
+     */
+    static BigInt factorial(unsigned n);
+
+    /**
+     * @brief Binomial coefficient; small k use the falling product divided by k!, the
+     *        rest the prime factorisation from Kummer's theorem.
+     * @param n The size of the set.
+     * @param k The size of the subsets.
+     * @return n choose k, which is 0 for k > n.
+     */
+    static BigInt binomial(unsigned n, unsigned k);
+
+    /**
+     * @brief Fibonacci number by fast doubling, two squares per bit of n.
+     * @param n The index, with F(0) = 0 and F(1) = 1.
+     * @return F(n).
+     */
+    static BigInt fibonacci(unsigned n);
+
+    /**
+     * @brief Product of all primes up to n.
+     * @param n The bound.
+     * @return n#, which is 1 for n < 2.
+     */
+    static BigInt primorial(unsigned n);
+
     std::string toString() const;
 
     //=================== I/O Stream Overloads ===================
@@ -125,26 +371,199 @@ public:
 
     friend std::istream &operator>>(std::istream &in, BigInt &b);
 
+    /**
+     * @brief Reads a decimal number from a stream in fixed-size chunks, without holding
+     *        its text in memory.
+     * @param in The stream; leading whitespace is skipped as for other formatted input.
+     * @param b Receives the value; unchanged if nothing could be read.
+     * @param maxDigits Largest number of digits accepted, leading zeros included.
+     * @return Reference to the stream; failbit is set if it held no number.
+     * @throws std::invalid_argument If the token is not a number or has more than
+     *         maxDigits digits, even when the stream throws on failbit; failbit is set
+     *         as well.
+     */
+    static std::istream &read(std::istream &in, BigInt &b,
+                              std::size_t maxDigits = std::numeric_limits<std::size_t>::max());
+
+    //=================== Modular Arithmetic ===================
+    // Declared in BigIntModular.h; they work on the limbs directly
+    friend class MontgomeryContext;
+
+    friend class BarrettReducer;
+
+    friend BigInt powMod(const BigInt &base, const BigInt &exponent, const BigInt &modulus);
+
+    // Implements gcd(), extendedGcd() and modInverse() in BigIntGcd.cpp
+    friend class BigIntGcd;
+
+    // Converts to and from its own inline limbs in FixedBigInt.h
+    template <std::size_t Bits>
+    friend class FixedBigInt;
+
+    // Reads and writes the limbs for BigIntView and the binary format in BigIntSerialization.cpp
+    friend class BigIntSerialization;
+
 private:
-    std::string number;
+    // Magnitude as base 2^64 limbs, least significant first. Zero is the empty vector,
+    // and the most significant limb is never zero. Values up to four limbs stay inline.
+    LimbVector limbs;
     bool isNegative;
 
     // Helper functions
     void removeLeadingZeros();
 
+    void assignScalar(unsigned __int128 magnitude, bool negative);
+
+    BigInt &addScalar(Limb magnitude, bool negative);
+
+    BigInt &multiplyScalar(Limb magnitude, bool negative);
+
+    BigInt &divideScalar(Limb magnitude, bool negative);
+
+    BigInt &remainderScalar(Limb magnitude);
+
+    BigInt &assignProduct(const BigInt &a, const BigInt &b);
+
+    BigInt &accumulateProduct(const BigInt &a, const BigInt &b, bool subtract);
+
+    template <typename T>
+    static Limb scalarMagnitude(T value);
+
+    template <typename T>
+    static bool scalarIsNegative(T value);
+
+    bool isZero() const;
+
+    template <typename Op>
+    BigInt &applyBitwise(const BigInt &other, Op op);
+
+    BigInt rootMagnitude(int k) const;
+
     bool isValid(const std::string &str) const;
 
-    std::string addStrings(const std::string &a, const std::string &b) const;
+    static void addMagnitudeInPlace(LimbVector &a, const LimbVector &b);
 
-    std::string subtractStrings(const std::string &a, const std::string &b) const;
+    static void subtractMagnitudeInPlace(LimbVector &a, const LimbVector &b);
 
-    std::string multiplyStrings(const std::string &a, const std::string &b) const;
+    static void reverseSubtractMagnitudeInPlace(LimbVector &a, const LimbVector &b);
 
-    std::pair<BigInt, BigInt> divide(const BigInt &other) const;
+    static LimbVector multiplyMagnitudes(const LimbVector &a, const LimbVector &b);
 
-    std::string karatsubaMultiply(const BigInt &x, const BigInt &y) const;
+    static LimbVector squareMagnitude(const LimbVector &a);
 
-    bool isSmaller(const std::string &a, const std::string &b) const;
+    std::pair<BigInt, BigInt> divide(const BigInt &other) const;
+
+    static int compareMagnitudes(const LimbVector &a, const LimbVector &b);
 };
 
+//=================== Scalar Operation Templates ===================
+
+template <typename T>
+BigInt::Limb BigInt::scalarMagnitude(T value) {
+    // Negate in unsigned arithmetic so the most negative value of T stays well defined
+    if (scalarIsNegative(value)) {
+        return Limb(0) - static_cast<Limb>(value);
+    }
+    return static_cast<Limb>(value);
+}
+
+template <typename T>
+bool BigInt::scalarIsNegative(T value) {
+    if constexpr (std::is_signed<T>::value) {
+        return value < 0;
+    } else {
+        return false;
+    }
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator+(T other) const & {
+    BigInt result = *this;
+    result += other;
+    return result;
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator+(T other) && {
+    *this += other;
+    return std::move(*this);
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator-(T other) const & {
+    BigInt result = *this;
+    result -= other;
+    return result;
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator-(T other) && {
+    *this -= other;
+    return std::move(*this);
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator*(T other) const & {
+    BigInt result = *this;
+    result *= other;
+    return result;
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator*(T other) && {
+    *this *= other;
+    return std::move(*this);
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator/(T other) const & {
+    BigInt result = *this;
+    result /= other;
+    return result;
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator/(T other) && {
+    *this /= other;
+    return std::move(*this);
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator%(T other) const & {
+    BigInt result = *this;
+    result %= other;
+    return result;
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt BigInt::operator%(T other) && {
+    *this %= other;
+    return std::move(*this);
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt &BigInt::operator+=(T other) {
+    return addScalar(scalarMagnitude(other), scalarIsNegative(other));
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt &BigInt::operator-=(T other) {
+    return addScalar(scalarMagnitude(other), !scalarIsNegative(other));
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt &BigInt::operator*=(T other) {
+    return multiplyScalar(scalarMagnitude(other), scalarIsNegative(other));
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt &BigInt::operator/=(T other) {
+    return divideScalar(scalarMagnitude(other), scalarIsNegative(other));
+}
+
+template <typename T, BigInt::EnableIfScalar<T>>
+BigInt &BigInt::operator%=(T other) {
+    return remainderScalar(scalarMagnitude(other));
+}
+
 #endif // BIGINT_H
\ No newline at end of file
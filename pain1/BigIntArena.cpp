@@ -0,0 +1,194 @@
+#include "BigIntArena.h"
+#include <algorithm>
+
+namespace {
+    // The arena installed by the innermost BigIntArena::Use on this thread, if any
+    thread_local BigIntArena *installed = nullptr;
+
+    // Smallest block worth allocating, in limbs
+    const std::size_t MINIMUM_BLOCK = 1024;
+}
+
+//========== Constructors ==========
+
+/**
+ * @brief Creates an arena with one block of the given size.
+ * @param limbs Number of limbs to preallocate; more blocks are added on demand.
+ */
+BigIntArena::BigIntArena(std::size_t limbs) : active(0) {
+    if (limbs > 0) {
+        addBlock(limbs);
+    }
+}
+
+//========== Destructor ==========
+
+/**
+ * @brief Frees every block.
+ */
+BigIntArena::~BigIntArena() {
+    for (Block &block : blocks) {
+        delete[] block.data;
+    }
+}
+
+//========== Allocation ==========
+
+/**
+ * @brief Uninitialised limbs that stay valid until the arena is rewound past them.
+ *
+ * Takes the limbs from the active block, moving on to a later block (or a new one, at
+ * least twice the size of the last) when it does not fit.
+ *
+ * @param count Number of limbs.
+ * @return Pointer to the first limb.
+ */
+BigIntArena::Limb *BigIntArena::allocate(std::size_t count) {
+    while (active < blocks.size() && blocks[active].size - blocks[active].used < count) {
+        // Later blocks are empty; skip any that are too small as well
+        ++active;
+    }
+    if (active == blocks.size()) {
+        std::size_t grown = blocks.empty() ? 0 : 2 * blocks.back().size;
+        addBlock(std::max(count, grown));
+    }
+    Block &block = blocks[active];
+    Limb *result = block.data + block.used;
+    block.used += count;
+    return result;
+}
+
+/**
+ * @brief The current position, for a later release().
+ * @return The marker.
+ */
+BigIntArena::Marker BigIntArena::mark() const {
+    return Marker{active, active < blocks.size() ? blocks[active].used : 0};
+}
+
+/**
+ * @brief Releases everything allocated since the marker was taken.
+ * @param marker A mark() of this arena that is not older than any still-live one.
+ */
+void BigIntArena::release(const Marker &marker) {
+    for (std::size_t i = marker.block + 1; i <= active && i < blocks.size(); ++i) {
+        blocks[i].used = 0;
+    }
+    active = marker.block;
+    if (active < blocks.size()) {
+        blocks[active].used = marker.used;
+    }
+    if (active == 0 && marker.used == 0) {
+        coalesce();
+    }
+}
+
+/**
+ * @brief Releases every allocation; the blocks are kept for reuse.
+ */
+void BigIntArena::reset() {
+    release(Marker{0, 0});
+}
+
+//========== Capacity ==========
+
+/**
+ * @brief Number of limbs currently handed out.
+ * @return The total over all blocks.
+ */
+std::size_t BigIntArena::used() const {
+    std::size_t total = 0;
+    for (const Block &block : blocks) {
+        total += block.used;
+    }
+    return total;
+}
+
+/**
+ * @brief Number of limbs held in all blocks.
+ * @return The total block size.
+ */
+std::size_t BigIntArena::capacity() const {
+    std::size_t total = 0;
+    for (const Block &block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+/**
+ * @brief The arena the current thread's kernels allocate from.
+ * @return The innermost arena installed with BigIntArena::Use, or the thread's default.
+ */
+BigIntArena &BigIntArena::current() {
+    if (installed != nullptr) {
+        return *installed;
+    }
+    thread_local BigIntArena local;
+    return local;
+}
+
+//========== Private Methods ==========
+
+/**
+ * @brief Appends an empty block of at least the given size.
+ * @param minimum Number of limbs the block must hold.
+ */
+void BigIntArena::addBlock(std::size_t minimum) {
+    std::size_t size = std::max(minimum, MINIMUM_BLOCK);
+    blocks.push_back(Block{new Limb[size], size, 0});
+}
+
+/**
+ * @brief Replaces several blocks of an empty arena with one that holds them all, so the
+ *        next round of allocations of the same sizes fits in a single block.
+ */
+void BigIntArena::coalesce() {
+    if (blocks.size() < 2) {
+        return;
+    }
+    std::size_t total = capacity();
+    for (Block &block : blocks) {
+        delete[] block.data;
+    }
+    blocks.clear();
+    active = 0;
+    addBlock(total);
+}
+
+//========== Scope ==========
+
+/**
+ * @brief Marks the current thread's arena.
+ */
+BigIntArena::Scope::Scope() : Scope(BigIntArena::current()) {}
+
+/**
+ * @brief Marks the given arena.
+ * @param arena The arena to allocate from.
+ */
+BigIntArena::Scope::Scope(BigIntArena &arena) : arena(arena), marker(arena.mark()) {}
+
+/**
+ * @brief Rewinds the arena to the mark taken on construction.
+ */
+BigIntArena::Scope::~Scope() {
+    arena.release(marker);
+}
+
+//========== Use ==========
+
+/**
+ * @brief Installs an arena as the current thread's scratch space.
+ * @param arena The arena; must outlive this object.
+ */
+BigIntArena::Use::Use(BigIntArena &arena) : previous(installed) {
+    installed = &arena;
+}
+
+/**
+ * @brief Restores the previously installed arena.
+ */
+BigIntArena::Use::~Use() {
+    installed = previous;
+}
@@ -0,0 +1,144 @@
+#ifndef BIGINT_ARENA_H
+#define BIGINT_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A stack-ordered scratch allocator for limb temporaries.
+ *
+ * Allocations are carved from preallocated blocks by bumping an offset and are released
+ * in bulk by rewinding to an earlier mark, so the recursive kernels never touch the
+ * general-purpose heap once the arena has grown to their working size. Each thread has
+ * its own arena, so there is no locking; a caller can install a presized arena of its
+ * own for a batch of computations with BigIntArena::Use.
+ */
+class BigIntArena {
+public:
+    using Limb = std::uint64_t;
+
+    /**
+     * @brief A position in the arena to rewind to.
+     */
+    struct Marker {
+        std::size_t block;
+        std::size_t used;
+    };
+
+    /**
+     * @brief Marks the current thread's arena on construction and rewinds it on
+     *        destruction, releasing everything allocated through it.
+     */
+    class Scope {
+    public:
+        Scope();
+
+        explicit Scope(BigIntArena &arena);
+
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        /**
+         * @brief Uninitialised limbs that stay valid until the scope ends.
+         * @param count Number of limbs.
+         * @return Pointer to the first limb.
+         */
+        Limb *allocate(std::size_t count) { return arena.allocate(count); }
+
+    private:
+        BigIntArena &arena;
+        Marker marker;
+    };
+
+    /**
+     * @brief Makes an arena the current thread's scratch space while it is alive, then
+     *        restores the previous one.
+     */
+    class Use {
+    public:
+        explicit Use(BigIntArena &arena);
+
+        ~Use();
+
+        Use(const Use &) = delete;
+
+        Use &operator=(const Use &) = delete;
+
+    private:
+        BigIntArena *previous;
+    };
+
+    //=================== Constructors ===================
+    /**
+     * @brief Creates an arena with one block of the given size.
+     * @param limbs Number of limbs to preallocate; more blocks are added on demand.
+     */
+    explicit BigIntArena(std::size_t limbs = 0);
+
+    BigIntArena(const BigIntArena &) = delete;
+
+    BigIntArena &operator=(const BigIntArena &) = delete;
+
+    //=================== Destructor ===================
+    ~BigIntArena();
+
+    //=================== Allocation ===================
+    /**
+     * @brief Uninitialised limbs that stay valid until the arena is rewound past them.
+     * @param count Number of limbs.
+     * @return Pointer to the first limb.
+     */
+    Limb *allocate(std::size_t count);
+
+    Marker mark() const;
+
+    /**
+     * @brief Releases everything allocated since the marker was taken.
+     * @param marker A mark() of this arena that is not older than any still-live one.
+     */
+    void release(const Marker &marker);
+
+    /**
+     * @brief Releases every allocation; the blocks are kept for reuse.
+     */
+    void reset();
+
+    //=================== Capacity ===================
+    /**
+     * @brief Number of limbs currently handed out.
+     */
+    std::size_t used() const;
+
+    /**
+     * @brief Number of limbs held in all blocks.
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief The arena the current thread's kernels allocate from: the innermost one
+     *        installed by BigIntArena::Use, or a per-thread default.
+     */
+    static BigIntArena &current();
+
+private:
+    struct Block {
+        Limb *data;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    // Blocks are only appended, so earlier allocations never move; active is the one
+    // allocations are taken from, and every block after it is empty
+    std::vector<Block> blocks;
+    std::size_t active;
+
+    void addBlock(std::size_t minimum);
+
+    void coalesce();
+};
+
+#endif // BIGINT_ARENA_H
@@ -0,0 +1,246 @@
+#include "BigInt.h"
+#include <algorithm>
+#include <vector>
+#include "BigIntKernels.h"
+#include "BigIntThreadPool.h"
+
+namespace {
+    using Limb = BigInt::Limb;
+
+    // Ranges up to this many words are multiplied one word at a time
+    const std::size_t PRODUCT_BASECASE = 16;
+
+    /**
+     * @brief The primes up to n, by a sieve over the odd numbers.
+     */
+    std::vector<Limb> primesUpTo(unsigned n) {
+        std::vector<Limb> primes;
+        if (n < 2) {
+            return primes;
+        }
+        primes.push_back(2);
+        // composite[i] stands for 2i + 1
+        std::vector<bool> composite(n / 2 + 1, false);
+        for (Limb i = 1; 2 * i + 1 <= n; ++i) {
+            if (composite[i]) {
+                continue;
+            }
+            Limb p = 2 * i + 1;
+            primes.push_back(p);
+            for (Limb multiple = p * p; multiple <= n; multiple += 2 * p) {
+                composite[multiple / 2] = true;
+            }
+        }
+        return primes;
+    }
+
+    /**
+     * @brief Multiplies runs of small factors together while they fit in a limb, so the
+     *        product tree starts from full words.
+     */
+    std::vector<Limb> packWords(const std::vector<Limb> &factors) {
+        std::vector<Limb> words;
+        unsigned __int128 word = 1;
+        for (Limb factor : factors) {
+            unsigned __int128 next = word * factor;
+            if (next >> 64 != 0) {
+                words.push_back(static_cast<Limb>(word));
+                next = factor;
+            }
+            word = next;
+        }
+        if (word != 1) {
+            words.push_back(static_cast<Limb>(word));
+        }
+        return words;
+    }
+
+    /**
+     * @brief Product of words[from, to) by a balanced tree, so both factors of every
+     *        multiplication have about the same size. Large enough branches run as tasks
+     *        while the thread pool is running.
+     */
+    BigInt productTree(const std::vector<Limb> &words, std::size_t from, std::size_t to) {
+        if (to - from <= PRODUCT_BASECASE) {
+            BigInt result = 1;
+            for (std::size_t i = from; i < to; ++i) {
+                result *= words[i];
+            }
+            return result;
+        }
+        std::size_t middle = from + (to - from) / 2;
+        if (to - from >= bigint_kernels::PARALLEL_THRESHOLD && BigIntThreadPool::running()) {
+            BigInt low;
+            BigIntThreadPool::TaskGroup tasks;
+            tasks.spawn([&] { low = productTree(words, from, middle); });
+            BigInt high = productTree(words, middle, to);
+            tasks.wait();
+            return low * high;
+        }
+        return productTree(words, from, middle) * productTree(words, middle, to);
+    }
+
+    BigInt product(const std::vector<Limb> &factors) {
+        std::vector<Limb> words = packWords(factors);
+        return productTree(words, 0, words.size());
+    }
+
+    /**
+     * @brief Product of primes[i]^exponents[i]. Primes are grouped by the bits of their
+     *        exponents, so the result is built by Horner's rule as
+     *        (...(P_top)^2 P_(top - 1))^2 ... P_0, where P_j is the product of the primes
+     *        whose exponent has bit j set.
+     */
+    BigInt powerProduct(const std::vector<Limb> &primes, const std::vector<Limb> &exponents) {
+        Limb all = 0;
+        for (Limb exponent : exponents) {
+            all |= exponent;
+        }
+        BigInt result = 1;
+        for (int bit = 63; bit >= 0; --bit) {
+            if ((all >> bit & 1) == 0) {
+                if (result != 1) {
+                    result = result.square();
+                }
+                continue;
+            }
+            std::vector<Limb> group;
+            for (std::size_t i = 0; i < primes.size(); ++i) {
+                if (exponents[i] >> bit & 1) {
+                    group.push_back(primes[i]);
+                }
+            }
+            if (result != 1) {
+                result = result.square();
+            }
+            result *= product(group);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Exponent of p in n!, by Legendre's formula.
+     */
+    Limb legendre(unsigned n, Limb p) {
+        Limb exponent = 0;
+        for (Limb q = n / p; q > 0; q /= p) {
+            exponent += q;
+        }
+        return exponent;
+    }
+}
+
+//========== Combinatorics ==========
+
+/**
+ * @brief n! from its prime factorisation.
+ *
+ * The odd part is the product of p^e over the odd primes p <= n, with e from Legendre's
+ * formula; the factor 2^(n - popcount(n)) is applied as a single shift at the end.
+ *
+ * @param n The argument.
+ * @return n!
+ */
+BigInt BigInt::factorial(unsigned n) {
+    if (n < 21) {
+        // Fits in a limb
+        Limb result = 1;
+        for (unsigned i = 2; i <= n; ++i) {
+            result *= i;
+        }
+        return BigInt(static_cast<unsigned long long>(result));
+    }
+    std::vector<Limb> primes = primesUpTo(n);
+    primes.erase(primes.begin());  // The power of two is a shift
+    std::vector<Limb> exponents;
+    exponents.reserve(primes.size());
+    for (Limb p : primes) {
+        exponents.push_back(legendre(n, p));
+    }
+    return powerProduct(primes, exponents) << (n - static_cast<unsigned>(__builtin_popcount(n)));
+}
+
+/**
+ * @brief Binomial coefficient n choose k.
+ *
+ * When the smaller of k and n - k is below n / 64, the falling product n (n - 1) ...
+ * is divided by the factorial of that count. Otherwise the coefficient is built from its
+ * prime factorisation, where the exponent of p counts the carries when adding k and
+ * n - k in base p (Kummer's theorem).
+ *
+ * @param n The size of the set.
+ * @param k The size of the subsets.
+ * @return n choose k, which is 0 for k > n.
+ */
+BigInt BigInt::binomial(unsigned n, unsigned k) {
+    if (k > n) {
+        return BigInt(0);
+    }
+    k = std::min(k, n - k);
+    if (k == 0) {
+        return BigInt(1);
+    }
+    if (static_cast<Limb>(k) * 64 < n) {
+        std::vector<Limb> falling;
+        falling.reserve(k);
+        for (unsigned i = 0; i < k; ++i) {
+            falling.push_back(n - i);
+        }
+        return product(falling) / factorial(k);
+    }
+    std::vector<Limb> primes = primesUpTo(n);
+    std::vector<Limb> used;
+    std::vector<Limb> exponents;
+    for (Limb p : primes) {
+        Limb exponent = legendre(n, p) - legendre(k, p) - legendre(n - k, p);
+        if (exponent > 0) {
+            used.push_back(p);
+            exponents.push_back(exponent);
+        }
+    }
+    return powerProduct(used, exponents);
+}
+
+/**
+ * @brief Fibonacci number by fast doubling.
+ *
+ * Keeps (F(j), F(j - 1)) while j runs through the leading bits of n. Each step doubles
+ * j with two squares, using F(2j + 1) = 4 F(j)^2 - F(j - 1)^2 + 2 (-1)^j and
+ * F(2j - 1) = F(j)^2 + F(j - 1)^2, and F(2j) as their difference.
+ *
+ * @param n The index, with F(0) = 0 and F(1) = 1.
+ * @return F(n).
+ */
+BigInt BigInt::fibonacci(unsigned n) {
+    if (n == 0) {
+        return BigInt(0);
+    }
+    BigInt current = 1;  // F(j)
+    BigInt previous = 0;  // F(j - 1)
+    bool odd = true;  // Parity of j
+    for (int bit = 30 - __builtin_clz(n); bit >= 0; --bit) {
+        BigInt currentSquare = current.square();
+        BigInt previousSquare = previous.square();
+        BigInt next = (currentSquare << 2) - previousSquare;  // F(2j + 1)
+        next += odd ? -2 : 2;
+        previous = std::move(currentSquare) + previousSquare;  // F(2j - 1)
+        current = next - previous;  // F(2j)
+        if (n >> bit & 1) {
+            previous = std::move(current);
+            current = std::move(next);
+            odd = true;
+        } else {
+            odd = false;
+        }
+    }
+    return current;
+}
+
+/**
+ * @brief Product of all primes up to n, by a product tree over the sieved primes.
+ * @param n The bound.
+ * @return n#, which is 1 for n < 2.
+ */
+BigInt BigInt::primorial(unsigned n) {
+    return product(primesUpTo(n));
+}
@@ -0,0 +1,243 @@
+#ifndef BIGINT_EXPRESSION_H
+#define BIGINT_EXPRESSION_H
+
+#include <type_traits>
+#include <utility>
+#include "BigInt.h"
+
+/**
+ * @brief Opt-in expression templates over BigInt.
+ *
+ * Wrapping an operand in lazy() makes the arithmetic around it build a small expression
+ * object instead of evaluating each operator. The whole expression is then evaluated
+ * in one go when it is converted to a BigInt or applied with += and -=:
+ *
+ *     using bigint_expr::lazy;
+ *     BigInt r = lazy(a) * b + c;            // c, then a * b accumulated into it
+ *     BigInt s = lazy(a) * b - lazy(c) * d;  // one product, then one fused subtraction
+ *     acc += lazy(x) * y;                    // no temporary for short products
+ *     BigInt t = (lazy(a) + b) % m;          // a conditional subtraction when a, b in [0, m)
+ *
+ * Products are accumulated with BigInt::addProduct() and BigInt::subtractProduct().
+ * Expressions hold references to their operands, so they must be evaluated within the
+ * full expression that creates them and never stored with auto.
+ */
+namespace bigint_expr {
+    /**
+     * @brief Base of every expression node. Each node provides assignTo(dest), which
+     *        stores its value into a fresh dest, accumulateInto(dest, subtract), which
+     *        adds or subtracts it, and uses(x), which tells whether x is an operand.
+     */
+    template <typename Derived>
+    class Expression {
+    public:
+        const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+        operator BigInt() const {
+            BigInt result;
+            self().assignTo(result);
+            return result;
+        }
+    };
+
+    /**
+     * @brief A BigInt operand.
+     */
+    class Ref : public Expression<Ref> {
+    public:
+        explicit Ref(const BigInt &value) : value(value) {}
+
+        void assignTo(BigInt &dest) const { dest = value; }
+
+        void accumulateInto(BigInt &dest, bool subtract) const {
+            if (subtract) {
+                dest -= value;
+            } else {
+                dest += value;
+            }
+        }
+
+        bool uses(const BigInt &x) const { return &value == &x; }
+
+        const BigInt &get() const { return value; }
+
+    private:
+        const BigInt &value;
+    };
+
+    /**
+     * @brief The product of two BigInt operands.
+     */
+    class Product : public Expression<Product> {
+    public:
+        Product(const BigInt &a, const BigInt &b) : a(a), b(b) {}
+
+        void assignTo(BigInt &dest) const { dest = a * b; }
+
+        void accumulateInto(BigInt &dest, bool subtract) const {
+            if (subtract) {
+                dest.subtractProduct(a, b);
+            } else {
+                dest.addProduct(a, b);
+            }
+        }
+
+        bool uses(const BigInt &x) const { return &a == &x || &b == &x; }
+
+    private:
+        const BigInt &a;
+        const BigInt &b;
+    };
+
+    /**
+     * @brief The sum (or difference, when Subtract is set) of two expressions.
+     */
+    template <typename Left, typename Right, bool Subtract>
+    class Sum : public Expression<Sum<Left, Right, Subtract>> {
+    public:
+        Sum(const Left &left, const Right &right) : left(left), right(right) {}
+
+        void assignTo(BigInt &dest) const {
+            if constexpr (std::is_same<Left, Product>::value && std::is_same<Right, Ref>::value) {
+                // Start from the plain operand, so the product is accumulated without a temporary
+                right.assignTo(dest);
+                if (Subtract) {
+                    dest = -std::move(dest);
+                }
+                left.accumulateInto(dest, false);
+            } else {
+                left.assignTo(dest);
+                right.accumulateInto(dest, Subtract);
+            }
+        }
+
+        void accumulateInto(BigInt &dest, bool subtract) const {
+            left.accumulateInto(dest, subtract);
+            right.accumulateInto(dest, subtract != Subtract);
+        }
+
+        bool uses(const BigInt &x) const { return left.uses(x) || right.uses(x); }
+
+    private:
+        Left left;
+        Right right;
+    };
+
+    /**
+     * @brief An expression reduced modulo a BigInt, with the sign of operator%.
+     */
+    template <typename Inner>
+    class Modulo : public Expression<Modulo<Inner>> {
+    public:
+        Modulo(const Inner &inner, const BigInt &modulus) : inner(inner), modulus(modulus) {}
+
+        void assignTo(BigInt &dest) const {
+            inner.assignTo(dest);
+            // A non-negative value below twice a positive modulus needs at most one
+            // subtraction, which is the common case for sums of reduced residues
+            if (dest >= 0 && modulus > 0) {
+                if (dest >= modulus) {
+                    dest -= modulus;
+                    if (dest >= modulus) {
+                        dest %= modulus;
+                    }
+                }
+            } else {
+                dest %= modulus;  // Also reports a zero modulus
+            }
+        }
+
+        void accumulateInto(BigInt &dest, bool subtract) const {
+            BigInt value = *this;
+            Ref(value).accumulateInto(dest, subtract);
+        }
+
+        bool uses(const BigInt &x) const { return inner.uses(x) || &modulus == &x; }
+
+    private:
+        Inner inner;
+        const BigInt &modulus;
+    };
+
+    /**
+     * @brief Starts an expression from a BigInt operand.
+     */
+    inline Ref lazy(const BigInt &value) {
+        return Ref(value);
+    }
+
+    //=================== Products ===================
+    inline Product operator*(const Ref &a, const Ref &b) {
+        return Product(a.get(), b.get());
+    }
+
+    inline Product operator*(const Ref &a, const BigInt &b) {
+        return Product(a.get(), b);
+    }
+
+    inline Product operator*(const BigInt &a, const Ref &b) {
+        return Product(a, b.get());
+    }
+
+    //=================== Sums and Differences ===================
+    template <typename Left, typename Right>
+    Sum<Left, Right, false> operator+(const Expression<Left> &left, const Expression<Right> &right) {
+        return Sum<Left, Right, false>(left.self(), right.self());
+    }
+
+    template <typename Left>
+    Sum<Left, Ref, false> operator+(const Expression<Left> &left, const BigInt &right) {
+        return Sum<Left, Ref, false>(left.self(), Ref(right));
+    }
+
+    template <typename Right>
+    Sum<Ref, Right, false> operator+(const BigInt &left, const Expression<Right> &right) {
+        return Sum<Ref, Right, false>(Ref(left), right.self());
+    }
+
+    template <typename Left, typename Right>
+    Sum<Left, Right, true> operator-(const Expression<Left> &left, const Expression<Right> &right) {
+        return Sum<Left, Right, true>(left.self(), right.self());
+    }
+
+    template <typename Left>
+    Sum<Left, Ref, true> operator-(const Expression<Left> &left, const BigInt &right) {
+        return Sum<Left, Ref, true>(left.self(), Ref(right));
+    }
+
+    template <typename Right>
+    Sum<Ref, Right, true> operator-(const BigInt &left, const Expression<Right> &right) {
+        return Sum<Ref, Right, true>(Ref(left), right.self());
+    }
+
+    //=================== Reduction ===================
+    template <typename Inner>
+    Modulo<Inner> operator%(const Expression<Inner> &inner, const BigInt &modulus) {
+        return Modulo<Inner>(inner.self(), modulus);
+    }
+
+    //=================== Compound Assignment ===================
+    // When the destination is also an operand the expression is evaluated on its own
+    // first, since accumulating in place would read already updated limbs.
+    template <typename Inner>
+    BigInt &operator+=(BigInt &dest, const Expression<Inner> &expression) {
+        if (expression.self().uses(dest)) {
+            BigInt value = expression;
+            return dest += value;
+        }
+        expression.self().accumulateInto(dest, false);
+        return dest;
+    }
+
+    template <typename Inner>
+    BigInt &operator-=(BigInt &dest, const Expression<Inner> &expression) {
+        if (expression.self().uses(dest)) {
+            BigInt value = expression;
+            return dest -= value;
+        }
+        expression.self().accumulateInto(dest, true);
+        return dest;
+    }
+}
+
+#endif // BIGINT_EXPRESSION_H
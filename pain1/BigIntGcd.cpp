@@ -0,0 +1,496 @@
+#include "BigIntModular.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "BigIntKernels.h"
+
+/**
+ * @brief GCD algorithms on BigInt magnitudes.
+ *
+ * Below HGCD_THRESHOLD limbs the GCD runs Lehmer steps: Euclidean quotients are taken
+ * from the leading 63 bits of both operands for as long as they are certain, and the
+ * resulting single-limb matrix is applied to the full operands in one pass. Larger
+ * operands use the half-GCD, which finds the matrix that halves both operands from
+ * their top halves by recursion and applies it with full-size multiplications, for
+ * O(M(n) log n) overall.
+ *
+ * A matrix M records (a0, b0) = M (a, b) for the original operands, so the extended
+ * GCD reads its cofactors from M once b reaches zero. Every matrix is unimodular, so a
+ * step taken from truncated operands can only cost progress, never correctness; the
+ * sign and order checks after each recursive step repair such steps.
+ */
+class BigIntGcd {
+public:
+    static BigInt gcd(const BigInt &a, const BigInt &b);
+
+    static BigInt extendedGcd(const BigInt &a, const BigInt &b, BigInt &x, BigInt &y);
+
+private:
+    using Limb = BigInt::Limb;
+    using SignedDoubleLimb = __int128;
+
+    struct Matrix {
+        BigInt m00 = 1;
+        BigInt m01 = 0;
+        BigInt m10 = 0;
+        BigInt m11 = 1;
+        int det = 1;
+    };
+
+    static Limb gcdWord(Limb u, Limb v);
+
+    static Limb leadingBits(const BigInt &x, size_t shift);
+
+    static BigInt high(const BigInt &x, size_t limbs);
+
+    static BigInt low(const BigInt &x, size_t limbs);
+
+    static void reduce(BigInt &a, BigInt &b, Matrix *m);
+
+    static Matrix halfGcd(BigInt &a, BigInt &b);
+
+    static void lehmerStep(BigInt &a, BigInt &b, Matrix *m);
+
+    static void divisionStep(BigInt &a, BigInt &b, Matrix *m);
+
+    static void combine(BigInt &u, BigInt &v, SignedDoubleLimb a, SignedDoubleLimb b,
+                        SignedDoubleLimb c, SignedDoubleLimb d);
+
+    static void applyInverse(const Matrix &m, const BigInt &aHigh, const BigInt &bHigh, BigInt &a, BigInt &b,
+                             size_t split);
+
+    static void normalize(BigInt &a, BigInt &b, Matrix *m);
+
+    static void multiply(Matrix &m, const Matrix &other);
+};
+
+//========== Entry Points ==========
+
+/**
+ * @brief Greatest common divisor of the magnitudes of a and b.
+ * @return The GCD, which is zero only when both operands are.
+ */
+BigInt BigIntGcd::gcd(const BigInt &a, const BigInt &b) {
+    BigInt u = a.isNegative ? -a : a;
+    BigInt v = b.isNegative ? -b : b;
+    normalize(u, v, nullptr);
+    reduce(u, v, nullptr);
+    return u;
+}
+
+/**
+ * @brief Greatest common divisor with cofactors.
+ *
+ * The cofactors are reduced to the smallest solution: for b != 0, x has the sign of a
+ * and |x| < |b| / g.
+ *
+ * @param x Receives the cofactor of a.
+ * @param y Receives the cofactor of b.
+ * @return The GCD g = a x + b y.
+ */
+BigInt BigIntGcd::extendedGcd(const BigInt &a, const BigInt &b, BigInt &x, BigInt &y) {
+    BigInt a0 = a.isNegative ? -a : a;
+    BigInt b0 = b.isNegative ? -b : b;
+    BigInt u = a0;
+    BigInt v = b0;
+    Matrix m;
+    normalize(u, v, &m);
+    reduce(u, v, &m);
+
+    // (a0, b0) = M (g, 0), and the inverse of M gives g = det (m11 a0 - m01 b0)
+    BigInt s = m.det > 0 ? m.m11 : -m.m11;
+    BigInt t = m.det > 0 ? -m.m01 : m.m01;
+    if (!b0.isZero() && !u.isZero()) {
+        BigInt period = b0 / u;
+        s %= period;
+        if (s.isNegative) {
+            s += period;
+        }
+        t = (u - a0 * s) / b0;
+    }
+    x = a.isNegative ? -s : s;
+    y = b.isNegative ? -t : t;
+    return u;
+}
+
+//========== Reduction ==========
+
+/**
+ * @brief Runs the Euclidean algorithm on a >= b >= 0 until b is zero, leaving the GCD
+ *        in a.
+ * @param m When not null, accumulates the matrix of all steps.
+ */
+void BigIntGcd::reduce(BigInt &a, BigInt &b, Matrix *m) {
+    while (!b.isZero()) {
+        size_t n = a.limbs.size();
+        if (n >= bigint_kernels::HGCD_THRESHOLD && 2 * b.limbs.size() > n) {
+            Matrix half = halfGcd(a, b);
+            if (m) {
+                multiply(*m, half);
+            }
+            if (!b.isZero()) {
+                divisionStep(a, b, m);
+            }
+        } else if (n == 1 && !m) {
+            a = gcdWord(a.limbs[0], b.limbs[0]);
+            b = 0;
+        } else if (b.limbs.size() + 1 < n) {
+            // Leading bits of b would be zero, so Lehmer could not take any quotient
+            divisionStep(a, b, m);
+        } else {
+            lehmerStep(a, b, m);
+        }
+    }
+}
+
+/**
+ * @brief Half-GCD: reduces a >= b >= 0 of n limbs by Euclidean steps until b has at
+ *        most n / 2 + 1 limbs.
+ *
+ * The first half of the quotients comes from a recursive call on the top n / 2 limbs,
+ * the second half from one on the top limbs of the partly reduced operands, each
+ * applied to the full operands by multiplying with its matrix.
+ *
+ * @return The matrix M with (a, b) on entry equal to M (a, b) on exit.
+ */
+BigIntGcd::Matrix BigIntGcd::halfGcd(BigInt &a, BigInt &b) {
+    Matrix m;
+    size_t n = a.limbs.size();
+    size_t s = n / 2 + 1;
+    if (n >= bigint_kernels::HGCD_THRESHOLD) {
+        size_t split = n / 2;
+        BigInt a1 = high(a, split);
+        BigInt b1 = high(b, split);
+        if (b1.limbs.size() > a1.limbs.size() / 2 + 1) {
+            m = halfGcd(a1, b1);
+            applyInverse(m, a1, b1, a, b, split);
+            normalize(a, b, &m);
+        }
+        if (b.limbs.size() > s) {
+            divisionStep(a, b, &m);
+        }
+        size_t n2 = a.limbs.size();
+        if (b.limbs.size() > s && n2 < 2 * s) {
+            // Split so that halving the top part lands just above s limbs
+            size_t k = 2 * s - n2;
+            BigInt a2 = high(a, k);
+            BigInt b2 = high(b, k);
+            if (b2.limbs.size() > a2.limbs.size() / 2 + 1) {
+                Matrix second = halfGcd(a2, b2);
+                applyInverse(second, a2, b2, a, b, k);
+                normalize(a, b, &second);
+                multiply(m, second);
+            }
+        }
+    }
+    while (b.limbs.size() > s) {
+        lehmerStep(a, b, &m);
+    }
+    return m;
+}
+
+/**
+ * @brief Lehmer step on a >= b > 0: takes the Euclidean quotients of the leading 63
+ *        bits that hold for any lower bits (Knuth's Algorithm L) and applies them to
+ *        the full operands at once, or makes a plain division step if there are none.
+ * @param m When not null, receives the step.
+ */
+void BigIntGcd::lehmerStep(BigInt &a, BigInt &b, Matrix *m) {
+    size_t bits = 64 * a.limbs.size() - static_cast<size_t>(__builtin_clzll(a.limbs.back()));
+    size_t shift = bits > 63 ? bits - 63 : 0;
+    SignedDoubleLimb x = leadingBits(a, shift);
+    SignedDoubleLimb y = leadingBits(b, shift);
+
+    // (x, y) approximates (A a + B b, C a + D b) / 2^shift
+    SignedDoubleLimb A = 1, B = 0, C = 0, D = 1;
+    while (y + C > 0 && y + D > 0) {
+        SignedDoubleLimb q = (x + A) / (y + C);
+        if (q != (x + B) / (y + D)) {
+            break;
+        }
+        SignedDoubleLimb t = A - q * C;
+        A = C;
+        C = t;
+        t = B - q * D;
+        B = D;
+        D = t;
+        t = x - q * y;
+        x = y;
+        y = t;
+    }
+    if (B == 0) {
+        divisionStep(a, b, m);
+        return;
+    }
+
+    combine(a, b, A, B, C, D);
+    if (m) {
+        // M' = M W^-1 with W^-1 = det(W) [D -B; -C A], one row at a time
+        SignedDoubleLimb det = A * D - B * C;
+        combine(m->m00, m->m01, det * D, -det * C, -det * B, det * A);
+        combine(m->m10, m->m11, det * D, -det * C, -det * B, det * A);
+        m->det *= static_cast<int>(det);
+    }
+    normalize(a, b, m);
+}
+
+/**
+ * @brief One Euclidean step (a, b) <- (b, a mod b) with a full division.
+ * @param m When not null, receives the step.
+ */
+void BigIntGcd::divisionStep(BigInt &a, BigInt &b, Matrix *m) {
+    std::pair<BigInt, BigInt> qr = a.divmod(b);
+    a = std::move(b);
+    b = std::move(qr.second);
+    if (m) {
+        // M' = M [q 1; 1 0]
+        BigInt t = m->m00 * qr.first + m->m01;
+        m->m01 = std::move(m->m00);
+        m->m00 = std::move(t);
+        t = m->m10 * qr.first + m->m11;
+        m->m11 = std::move(m->m10);
+        m->m10 = std::move(t);
+        m->det = -m->det;
+    }
+}
+
+//========== Matrix Helpers ==========
+
+/**
+ * @brief Replaces (u, v) by (a u + b v, c u + d v) in a single pass over the limbs, for
+ *        coefficients below 2^63 in magnitude.
+ *
+ * Signs of u and v are folded into the coefficients, and each result is accumulated
+ * with a signed carry into one extra limb, whose final value of 0 or -1 gives its sign.
+ */
+void BigIntGcd::combine(BigInt &u, BigInt &v, SignedDoubleLimb a, SignedDoubleLimb b,
+                        SignedDoubleLimb c, SignedDoubleLimb d) {
+    if (u.isNegative) {
+        a = -a;
+        c = -c;
+    }
+    if (v.isNegative) {
+        b = -b;
+        d = -d;
+    }
+    size_t n = std::max(u.limbs.size(), v.limbs.size()) + 1;
+    u.limbs.resize(n);
+    v.limbs.resize(n);
+    SignedDoubleLimb carryU = 0;
+    SignedDoubleLimb carryV = 0;
+    for (size_t i = 0; i < n; ++i) {
+        SignedDoubleLimb digitU = u.limbs[i];
+        SignedDoubleLimb digitV = v.limbs[i];
+        SignedDoubleLimb newU = a * digitU + b * digitV + carryU;
+        SignedDoubleLimb newV = c * digitU + d * digitV + carryV;
+        u.limbs[i] = static_cast<Limb>(newU);
+        v.limbs[i] = static_cast<Limb>(newV);
+        carryU = newU >> 64;
+        carryV = newV >> 64;
+    }
+    auto setSign = [](BigInt &x, SignedDoubleLimb carry) {
+        x.isNegative = carry < 0;
+        if (x.isNegative) {
+            // Two's complement negation of the limbs gives the magnitude
+            Limb borrow = 0;
+            for (Limb &limb: x.limbs) {
+                Limb digit = limb;
+                limb = 0 - digit - borrow;
+                borrow = (digit != 0 || borrow != 0) ? 1 : 0;
+            }
+        }
+        x.removeLeadingZeros();
+    };
+    setSign(u, carryU);
+    setSign(v, carryV);
+}
+
+/**
+ * @brief Replaces (a, b) by M^-1 (a, b), where M came from a half-GCD of their top
+ *        limbs.
+ *
+ * Writing a = aHigh B^split + aLow, the top part of the result is the reduced
+ * (aHigh, bHigh) the recursion already produced, so only the low limbs are multiplied:
+ * M^-1 (aLow, bLow) = det [m11 -m01; -m10 m00] (aLow, bLow).
+ *
+ * @param aHigh Top limbs of a after reduction by M.
+ * @param bHigh Top limbs of b after reduction by M.
+ * @param split Number of low limbs.
+ */
+void BigIntGcd::applyInverse(const Matrix &m, const BigInt &aHigh, const BigInt &bHigh, BigInt &a, BigInt &b,
+                             size_t split) {
+    BigInt aLow = low(a, split);
+    BigInt bLow = low(b, split);
+    BigInt newA = m.m11 * aLow - m.m01 * bLow;
+    BigInt newB = m.m00 * bLow - m.m10 * aLow;
+    if (m.det < 0) {
+        newA = -std::move(newA);
+        newB = -std::move(newB);
+    }
+
+    // x = xHigh B^split + xLow; the high parts are non-negative
+    auto place = [split](BigInt &x, const BigInt &xHigh, const BigInt &xLow) {
+        x.limbs.assign(split + xHigh.limbs.size(), 0);
+        std::copy(xHigh.limbs.begin(), xHigh.limbs.end(), x.limbs.begin() + split);
+        x.isNegative = false;
+        x.removeLeadingZeros();
+        x += xLow;
+    };
+    place(a, aHigh, newA);
+    place(b, bHigh, newB);
+}
+
+/**
+ * @brief Makes a and b non-negative with a >= b, adjusting M so that M (a, b) is
+ *        unchanged.
+ * @param m When not null, the matrix to adjust.
+ */
+void BigIntGcd::normalize(BigInt &a, BigInt &b, Matrix *m) {
+    if (a.isNegative) {
+        a = -std::move(a);
+        if (m) {
+            m->m00 = -std::move(m->m00);
+            m->m10 = -std::move(m->m10);
+            m->det = -m->det;
+        }
+    }
+    if (b.isNegative) {
+        b = -std::move(b);
+        if (m) {
+            m->m01 = -std::move(m->m01);
+            m->m11 = -std::move(m->m11);
+            m->det = -m->det;
+        }
+    }
+    if (BigInt::compareMagnitudes(a.limbs, b.limbs) < 0) {
+        std::swap(a, b);
+        if (m) {
+            std::swap(m->m00, m->m01);
+            std::swap(m->m10, m->m11);
+            m->det = -m->det;
+        }
+    }
+}
+
+/**
+ * @brief Replaces M by M other.
+ */
+void BigIntGcd::multiply(Matrix &m, const Matrix &other) {
+    BigInt n00 = m.m00 * other.m00 + m.m01 * other.m10;
+    BigInt n01 = m.m00 * other.m01 + m.m01 * other.m11;
+    BigInt n10 = m.m10 * other.m00 + m.m11 * other.m10;
+    BigInt n11 = m.m10 * other.m01 + m.m11 * other.m11;
+    m.m00 = std::move(n00);
+    m.m01 = std::move(n01);
+    m.m10 = std::move(n10);
+    m.m11 = std::move(n11);
+    m.det *= other.det;
+}
+
+//========== Limb Helpers ==========
+
+/**
+ * @brief Binary GCD of two single limbs.
+ */
+BigInt::Limb BigIntGcd::gcdWord(Limb u, Limb v) {
+    if (u == 0 || v == 0) {
+        return u | v;
+    }
+    int shift = __builtin_ctzll(u | v);
+    u >>= __builtin_ctzll(u);
+    do {
+        v >>= __builtin_ctzll(v);
+        if (u > v) {
+            std::swap(u, v);
+        }
+        v -= u;
+    } while (v != 0);
+    return u << shift;
+}
+
+/**
+ * @brief The 63 bits of the magnitude of x starting at bit shift.
+ */
+BigInt::Limb BigIntGcd::leadingBits(const BigInt &x, size_t shift) {
+    size_t index = shift / 64;
+    unsigned bit = shift % 64;
+    if (index >= x.limbs.size()) {
+        return 0;
+    }
+    Limb bits = x.limbs[index] >> bit;
+    if (bit != 0 && index + 1 < x.limbs.size()) {
+        bits |= x.limbs[index + 1] << (64 - bit);
+    }
+    return bits & ((Limb(1) << 63) - 1);
+}
+
+/**
+ * @brief The magnitude of x shifted down by the given number of limbs.
+ */
+BigInt BigIntGcd::high(const BigInt &x, size_t limbs) {
+    BigInt result;
+    if (x.limbs.size() > limbs) {
+        result.limbs.resize(x.limbs.size() - limbs);
+        std::copy(x.limbs.begin() + limbs, x.limbs.end(), result.limbs.begin());
+    }
+    return result;
+}
+
+/**
+ * @brief The magnitude of x modulo B^limbs.
+ */
+BigInt BigIntGcd::low(const BigInt &x, size_t limbs) {
+    BigInt result;
+    size_t size = std::min(limbs, x.limbs.size());
+    result.limbs.resize(size);
+    std::copy(x.limbs.begin(), x.limbs.begin() + size, result.limbs.begin());
+    result.removeLeadingZeros();
+    return result;
+}
+
+//========== GCD and Modular Inverse ==========
+
+/**
+ * @brief Greatest common divisor of a and b.
+ * @param a The first operand; its sign is ignored.
+ * @param b The second operand; its sign is ignored.
+ * @return The non-negative GCD, which is zero only when both operands are.
+ */
+BigInt gcd(const BigInt &a, const BigInt &b) {
+    return BigIntGcd::gcd(a, b);
+}
+
+/**
+ * @brief Extended GCD: finds g = gcd(a, b) and x, y with a x + b y = g.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param x Receives the cofactor of a; when b != 0 it has the sign of a and |x| < |b| / g.
+ * @param y Receives the cofactor of b.
+ * @return The non-negative GCD.
+ */
+BigInt extendedGcd(const BigInt &a, const BigInt &b, BigInt &x, BigInt &y) {
+    return BigIntGcd::extendedGcd(a, b, x, y);
+}
+
+/**
+ * @brief Inverse of a modulo a positive modulus.
+ * @param a The value to invert; may be negative or larger than the modulus.
+ * @param modulus The positive modulus.
+ * @return The x in [0, modulus) with a x = 1 mod modulus.
+ * @throws std::invalid_argument If the modulus is not positive or a is not coprime to it.
+ */
+BigInt modInverse(const BigInt &a, const BigInt &modulus) {
+    if (modulus <= 0) {
+        throw std::invalid_argument("modInverse modulus must be positive");
+    }
+    BigInt reduced = a % modulus;
+    if (reduced < 0) {
+        reduced += modulus;
+    }
+    BigInt x;
+    BigInt y;
+    if (extendedGcd(reduced, modulus, x, y) != 1) {
+        throw std::invalid_argument("BigInt is not invertible modulo the given modulus");
+    }
+    return x;
+}
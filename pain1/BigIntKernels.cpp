@@ -0,0 +1,1011 @@
+#include "BigIntKernels.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "BigIntArena.h"
+#include "BigIntThreadPool.h"
+
+namespace bigint_kernels {
+    namespace {
+        using DoubleLimb = unsigned __int128;
+
+        /**
+         * @brief Computes d = |x - y| where x has xn limbs and y has yn <= xn limbs.
+         * @param d Output buffer of xn limbs.
+         * @return True if x < y, i.e. the difference is negative.
+         */
+        bool absoluteDifference(Limb *d, const Limb *x, std::size_t xn, const Limb *y, std::size_t yn) {
+            if (compare(x, xn, y, yn) >= 0) {
+                subtract(d, x, xn, y, yn);
+                return false;
+            }
+            // y > x means the limbs of x above yn are all zero
+            subtractN(d, y, x, yn);
+            std::fill(d + yn, d + xn, 0);
+            return true;
+        }
+
+        /**
+         * @brief A signed value with a normalised magnitude, used for Toom evaluation
+         *        and interpolation where intermediate values may go negative.
+         */
+        struct SignedLimbs {
+            std::vector<Limb> magnitude;
+            bool negative = false;
+        };
+
+        /**
+         * @brief Divides the two-limb value (high, low) by a normalised d with high < d,
+         *        using the precomputed reciprocal (Moller and Granlund, 2011).
+         * @param remainder Receives (high, low) mod d.
+         * @return The quotient limb.
+         */
+        Limb divideTwoByOne(Limb &remainder, Limb high, Limb low, Limb d, Limb inverse) {
+            DoubleLimb estimate = static_cast<DoubleLimb>(inverse) * high +
+                                  ((static_cast<DoubleLimb>(high) << 64) | low);
+            Limb q = static_cast<Limb>(estimate >> 64) + 1;
+            Limb r = low - q * d;
+            if (r > static_cast<Limb>(estimate)) {
+                --q;
+                r += d;
+            }
+            if (r >= d) {
+                ++q;
+                r -= d;
+            }
+            remainder = r;
+            return q;
+        }
+
+        void trim(std::vector<Limb> &v) {
+            while (!v.empty() && v.back() == 0) {
+                v.pop_back();
+            }
+        }
+
+        std::vector<Limb> toVector(const Limb *p, std::size_t n) {
+            std::vector<Limb> v(p, p + n);
+            trim(v);
+            return v;
+        }
+
+        std::vector<Limb> multiplyVectors(const std::vector<Limb> &x, const std::vector<Limb> &y) {
+            if (x.empty() || y.empty()) {
+                return {};
+            }
+            std::vector<Limb> product(x.size() + y.size());
+            multiply(product.data(), x.data(), x.size(), y.data(), y.size());
+            trim(product);
+            return product;
+        }
+
+        std::vector<Limb> squareVector(const std::vector<Limb> &x) {
+            if (x.empty()) {
+                return {};
+            }
+            std::vector<Limb> product(2 * x.size());
+            square(product.data(), x.data(), x.size());
+            trim(product);
+            return product;
+        }
+
+        /**
+         * @brief Computes acc += (negative ? -value : value).
+         */
+        void accumulate(SignedLimbs &acc, const std::vector<Limb> &value, bool negative) {
+            std::vector<Limb> &m = acc.magnitude;
+            if (acc.negative == negative || m.empty()) {
+                if (m.empty()) {
+                    acc.negative = negative;
+                }
+                if (m.size() < value.size()) {
+                    m.resize(value.size(), 0);
+                }
+                Limb carry = add(m.data(), m.data(), m.size(), value.data(), value.size());
+                if (carry != 0) {
+                    m.push_back(carry);
+                }
+            } else if (compare(m.data(), m.size(), value.data(), value.size()) >= 0) {
+                subtract(m.data(), m.data(), m.size(), value.data(), value.size());
+            } else {
+                m.resize(value.size(), 0);
+                subtractN(m.data(), value.data(), m.data(), value.size());
+                acc.negative = negative;
+            }
+            trim(m);
+            if (m.empty()) {
+                acc.negative = false;
+            }
+        }
+
+        void accumulate(SignedLimbs &acc, const SignedLimbs &value, bool subtractIt) {
+            accumulate(acc, value.magnitude, value.negative != subtractIt);
+        }
+
+        /**
+         * @brief Multiplies a signed value by a small signed integer in place.
+         */
+        void scale(SignedLimbs &value, long long factor) {
+            Limb m = static_cast<Limb>(factor < 0 ? -factor : factor);
+            Limb carry = multiply1(value.magnitude.data(), value.magnitude.data(), value.magnitude.size(), m);
+            if (carry != 0) {
+                value.magnitude.push_back(carry);
+            }
+            trim(value.magnitude);
+            value.negative = !value.magnitude.empty() && (value.negative != (factor < 0));
+        }
+
+        /**
+         * @brief Divides a signed value by 2 or 3, which must divide it exactly.
+         */
+        void divideExact(SignedLimbs &value, Limb d) {
+            std::vector<Limb> &m = value.magnitude;
+            if (d == 2) {
+                for (std::size_t i = 0; i < m.size(); ++i) {
+                    m[i] = (m[i] >> 1) | (i + 1 < m.size() ? m[i + 1] << 63 : 0);
+                }
+            } else {
+                divideExact1(m.data(), m.data(), m.size(), d);
+            }
+            trim(m);
+        }
+
+        /**
+         * @brief Evaluates the polynomial with the given coefficients at a small point.
+         */
+        SignedLimbs evaluate(const std::vector<std::vector<Limb>> &parts, long long point) {
+            SignedLimbs acc;
+            for (std::size_t i = parts.size(); i-- > 0;) {
+                scale(acc, point);
+                accumulate(acc, parts[i], false);
+            }
+            return acc;
+        }
+
+        SignedLimbs multiplySigned(const SignedLimbs &x, const SignedLimbs &y) {
+            SignedLimbs product;
+            product.magnitude = multiplyVectors(x.magnitude, y.magnitude);
+            product.negative = !product.magnitude.empty() && (x.negative != y.negative);
+            return product;
+        }
+
+        /**
+         * @brief Pointwise Toom product at one evaluation point; squares when the two
+         *        operands are the same split.
+         */
+        SignedLimbs pointwise(const std::vector<std::vector<Limb>> &as, const std::vector<std::vector<Limb>> &bs,
+                              long long point, bool squaring) {
+            SignedLimbs x = evaluate(as, point);
+            if (squaring) {
+                SignedLimbs product;
+                product.magnitude = squareVector(x.magnitude);
+                return product;
+            }
+            return multiplySigned(x, evaluate(bs, point));
+        }
+
+        /**
+         * @brief Forms z1 = z0 + z2 -/+ middle from the three Karatsuba sub-products and adds
+         *        it into r at offset low.
+         * @param r Holds z0 in its low 2 * low limbs and z2 above them.
+         * @param middle The product of the half differences, 2 * low limbs.
+         * @param subtractMiddle True if the product of the half differences is non-negative.
+         * @param z1 Scratch of 2 * low + 1 limbs.
+         */
+        void combineKaratsuba(Limb *r, const Limb *middle, std::size_t low, std::size_t high,
+                              bool subtractMiddle, Limb *z1) {
+            z1[2 * low] = add(z1, r, 2 * low, r + 2 * low, 2 * high);
+            if (subtractMiddle) {
+                subtract(z1, z1, 2 * low + 1, middle, 2 * low);
+            } else {
+                add(z1, z1, 2 * low + 1, middle, 2 * low);
+            }
+
+            // The top limbs of z1 beyond the product's width are necessarily zero
+            std::size_t z1Size = std::min(2 * low + 1, low + 2 * high);
+            add(r + low, r + low, low + 2 * high, z1, z1Size);
+        }
+
+        /**
+         * @brief Splits an n-limb operand into `parts` pieces of k limbs; the top piece
+         *        takes whatever is left and may be shorter or empty.
+         */
+        std::vector<std::vector<Limb>> split(const Limb *a, std::size_t n, std::size_t parts, std::size_t k) {
+            std::vector<std::vector<Limb>> pieces;
+            for (std::size_t i = 0; i < parts; ++i) {
+                std::size_t from = std::min(i * k, n);
+                std::size_t to = (i + 1 == parts) ? n : std::min(from + k, n);
+                pieces.push_back(toVector(a + from, to - from));
+            }
+            return pieces;
+        }
+
+        /**
+         * @brief Multiplies a by b one bn-limb block of a at a time.
+         * @param r Output of an + bn limbs, an >= bn.
+         */
+        void multiplyBlocks(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+            multiply(r, a, bn, b, bn);
+            std::fill(r + 2 * bn, r + an + bn, 0);
+
+            BigIntArena::Scope scratch;
+            Limb *partial = scratch.allocate(2 * bn);
+            for (std::size_t offset = bn; offset < an; offset += bn) {
+                std::size_t blockSize = std::min(bn, an - offset);
+                multiply(partial, a + offset, blockSize, b, bn);
+                add(r + offset, r + offset, an + bn - offset, partial, blockSize + bn);
+            }
+        }
+
+        /**
+         * @brief Adds (or subtracts) one at limb `position` of an m-limb quotient whose
+         *        overflow limb is kept separately in `top`.
+         */
+        void adjustQuotient(Limb *q, std::size_t m, Limb &top, std::size_t position, bool increment) {
+            for (std::size_t i = position; i < m; ++i) {
+                if (increment ? ++q[i] != 0 : q[i]-- != 0) {
+                    return;
+                }
+            }
+            increment ? ++top : --top;
+        }
+
+        /**
+         * @brief Computes product = (top * B^qn + q) * b for an n-limb b, in qn + n + 1 limbs.
+         */
+        void multiplyQuotient(Limb *product, const Limb *q, std::size_t qn, Limb top,
+                              const Limb *b, std::size_t n) {
+            std::fill(product, product + qn + n + 1, 0);
+            if (qn > 0 && n > 0) {
+                multiply(product, q, qn, b, n);
+            }
+            if (top != 0) {
+                product[qn + n] += addMultiply1(product + qn, b, n, top);
+            }
+        }
+
+        /**
+         * @brief Recursive division of an (n + m)-limb window by a normalised n-limb divisor,
+         *        m <= n (Burnikel-Ziegler, in the form of Brent and Zimmermann's
+         *        RecursiveDivRem).
+         *
+         * The top m quotient limbs are found by dividing the high part by the high n - m/2
+         * limbs of b, then corrected against the dropped low limbs with one big
+         * multiplication; the low half repeats the step. Corrections are bounded because b
+         * is normalised.
+         *
+         * @param q Receives the low m quotient limbs.
+         * @param a The window, n + m limbs; on return its low n limbs hold the remainder and
+         *          the rest are zero.
+         * @return The quotient limb above q, which is 0 or 1.
+         */
+        Limb divideRecursive(Limb *q, Limb *a, std::size_t n, std::size_t m, const Limb *b) {
+            BigIntArena::Scope scratch;
+            if (m < DIVIDE_THRESHOLD) {
+                Limb *quotient = scratch.allocate(m + 1);
+                Limb *remainder = scratch.allocate(n);
+                divideBasecase(quotient, remainder, a, n + m, b, n);
+                std::copy(quotient, quotient + m, q);
+                std::copy(remainder, remainder + n, a);
+                std::fill(a + n, a + n + m, 0);
+                return quotient[m];
+            }
+
+            Limb top = 0;
+            if (compare(a + m, n, b, n) >= 0) {
+                subtractN(a + m, a + m, b, n);
+                top = 1;
+            }
+
+            std::size_t k = m / 2;
+            Limb *product = scratch.allocate(m + 1);  // Holds both corrections below
+
+            // (Q1, R1) = (A div B^2k) divrem (B div B^k); the remainder lands in a[2k, n + k).
+            // Q1's own top limb is kept apart from the one above, whose B B^m is already
+            // fully subtracted.
+            Limb highTop = divideRecursive(q + k, a + 2 * k, n - k, m - k, b + k);
+
+            // A' = R1 B^2k + (A mod B^2k) - Q1 (B mod B^k) B^k, adding B B^k back while negative
+            std::size_t width = n + m - k;
+            multiplyQuotient(product, q + k, m - k, highTop, b, k);
+            Limb borrow = subtract(a + k, a + k, width, product, m + 1);
+            while (borrow != 0) {
+                adjustQuotient(q + k, m - k, highTop, 0, false);
+                borrow -= add(a + k, a + k, width, b, n);
+            }
+            top += highTop;
+
+            // (Q0, R0) = (A' div B^k) divrem (B div B^k); the remainder lands in a[k, n)
+            Limb lowTop = divideRecursive(q, a + k, n - k, k, b + k);
+            if (lowTop != 0) {
+                adjustQuotient(q, m, top, k, true);
+            }
+
+            // A'' = R0 B^k + (A' mod B^k) - Q0 (B mod B^k), adding B back while negative
+            multiplyQuotient(product, q, k, lowTop, b, k);
+            borrow = subtract(a, a, n + m, product, 2 * k + 1);
+            while (borrow != 0) {
+                adjustQuotient(q, m, top, 0, false);
+                borrow -= add(a, a, n + m, b, n);
+            }
+            return top;
+        }
+    }
+
+    /**
+     * @brief Compares two limb arrays as unsigned integers.
+     * @param a First operand of an limbs.
+     * @param b Second operand of bn limbs.
+     * @return Negative if a < b, zero if a == b, positive if a > b.
+     */
+    int compare(const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+        // Leading zero limbs do not change the value
+        while (an > bn) {
+            if (a[--an] != 0) return 1;
+        }
+        while (bn > an) {
+            if (b[--bn] != 0) return -1;
+        }
+        for (std::size_t i = an; i-- > 0;) {
+            if (a[i] != b[i]) {
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Computes r = a + b for two n-limb operands. r may alias a or b.
+     * @return The carry out of the top limb.
+     */
+    Limb addN(Limb *r, const Limb *a, const Limb *b, std::size_t n) {
+        Limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            Limb sum = a[i] + carry;
+            carry = sum < carry ? 1 : 0;
+            Limb digitB = b[i];
+            sum += digitB;
+            carry += sum < digitB ? 1 : 0;
+            r[i] = sum;
+        }
+        return carry;
+    }
+
+    /**
+     * @brief Computes r = a + b where an >= bn. r has an limbs and may alias a or b.
+     * @return The carry out of the top limb.
+     */
+    Limb add(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+        Limb carry = addN(r, a, b, bn);
+        for (std::size_t i = bn; i < an; ++i) {
+            Limb sum = a[i] + carry;
+            carry = sum < carry ? 1 : 0;
+            r[i] = sum;
+        }
+        return carry;
+    }
+
+    /**
+     * @brief Computes r = a - b for two n-limb operands. r may alias a or b.
+     * @return The borrow out of the top limb.
+     */
+    Limb subtractN(Limb *r, const Limb *a, const Limb *b, std::size_t n) {
+        Limb borrow = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            Limb digitA = a[i];
+            Limb digitB = b[i];
+            r[i] = digitA - digitB - borrow;
+            borrow = (digitA < digitB || (digitA == digitB && borrow != 0)) ? 1 : 0;
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief Computes r = a - b where an >= bn. r has an limbs and may alias a or b.
+     * @return The borrow out of the top limb.
+     */
+    Limb subtract(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+        Limb borrow = subtractN(r, a, b, bn);
+        for (std::size_t i = bn; i < an; ++i) {
+            Limb digitA = a[i];
+            r[i] = digitA - borrow;
+            borrow = (digitA < borrow) ? 1 : 0;
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief Computes r = a * m for an n-limb operand and a single limb.
+     * @return The high limb of the product.
+     */
+    Limb multiply1(Limb *r, const Limb *a, std::size_t n, Limb m) {
+        Limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            DoubleLimb product = static_cast<DoubleLimb>(a[i]) * m + carry;
+            r[i] = static_cast<Limb>(product);
+            carry = static_cast<Limb>(product >> 64);
+        }
+        return carry;
+    }
+
+    /**
+     * @brief Computes r += a * m for an n-limb operand and a single limb.
+     * @return The limb carried out of r[n - 1].
+     */
+    Limb addMultiply1(Limb *r, const Limb *a, std::size_t n, Limb m) {
+        Limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            DoubleLimb product = static_cast<DoubleLimb>(a[i]) * m + r[i] + carry;
+            r[i] = static_cast<Limb>(product);
+            carry = static_cast<Limb>(product >> 64);
+        }
+        return carry;
+    }
+
+    /**
+     * @brief Computes r -= a * m for an n-limb operand and a single limb.
+     * @return The limb borrowed out of r[n - 1].
+     */
+    Limb subtractMultiply1(Limb *r, const Limb *a, std::size_t n, Limb m) {
+        Limb borrow = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            DoubleLimb product = static_cast<DoubleLimb>(a[i]) * m + borrow;
+            Limb low = static_cast<Limb>(product);
+            borrow = static_cast<Limb>(product >> 64) + (r[i] < low ? 1 : 0);
+            r[i] -= low;
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief Computes r = a << shift for 0 <= shift < 64. r may alias a.
+     * @return The bits shifted out of the top limb.
+     */
+    Limb shiftLeft(Limb *r, const Limb *a, std::size_t n, unsigned shift) {
+        if (shift == 0) {
+            std::copy(a, a + n, r);
+            return 0;
+        }
+        Limb out = 0;
+        for (std::size_t i = n; i-- > 0;) {
+            Limb limb = a[i];
+            if (i + 1 == n) {
+                out = limb >> (64 - shift);
+            }
+            r[i] = (limb << shift) | (i > 0 ? a[i - 1] >> (64 - shift) : 0);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Computes r = a >> shift for 0 <= shift < 64. r may alias a.
+     * @return The bits shifted out of the bottom limb, in the high end of the result.
+     */
+    Limb shiftRight(Limb *r, const Limb *a, std::size_t n, unsigned shift) {
+        if (shift == 0) {
+            std::copy(a, a + n, r);
+            return 0;
+        }
+        Limb out = n > 0 ? a[0] << (64 - shift) : 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            r[i] = (a[i] >> shift) | (i + 1 < n ? a[i + 1] << (64 - shift) : 0);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Reciprocal floor((B^2 - 1) / d) - B of a normalised divisor (top bit set),
+     *        as used by divideTwoByOne.
+     */
+    Limb reciprocal(Limb d) {
+        return static_cast<Limb>(((static_cast<DoubleLimb>(~d) << 64) | ~Limb(0)) / d);
+    }
+
+    /**
+     * @brief Computes q = a / d for a single-limb divisor. q may alias a.
+     *
+     * The divisor is normalised once and every step uses its precomputed reciprocal, so
+     * the loop runs on multiplications instead of hardware division.
+     *
+     * @return The remainder a mod d.
+     */
+    Limb divide1(Limb *q, const Limb *a, std::size_t n, Limb d) {
+        unsigned shift = static_cast<unsigned>(__builtin_clzll(d));
+        Limb normalised = d << shift;
+        Limb inverse = reciprocal(normalised);
+
+        // Feed the dividend shifted left by `shift`, one limb at a time from the top
+        Limb remainder = (n != 0 && shift != 0) ? a[n - 1] >> (64 - shift) : 0;
+        for (std::size_t i = n; i-- > 0;) {
+            Limb limb = a[i] << shift;
+            if (shift != 0 && i > 0) {
+                limb |= a[i - 1] >> (64 - shift);
+            }
+            q[i] = divideTwoByOne(remainder, remainder, limb, normalised, inverse);
+        }
+        return remainder >> shift;
+    }
+
+    /**
+     * @brief Computes a mod d for a single-limb divisor without writing a quotient.
+     */
+    Limb remainder1(const Limb *a, std::size_t n, Limb d) {
+        unsigned shift = static_cast<unsigned>(__builtin_clzll(d));
+        Limb normalised = d << shift;
+        Limb inverse = reciprocal(normalised);
+
+        Limb remainder = (n != 0 && shift != 0) ? a[n - 1] >> (64 - shift) : 0;
+        for (std::size_t i = n; i-- > 0;) {
+            Limb limb = a[i] << shift;
+            if (shift != 0 && i > 0) {
+                limb |= a[i - 1] >> (64 - shift);
+            }
+            divideTwoByOne(remainder, remainder, limb, normalised, inverse);
+        }
+        return remainder >> shift;
+    }
+
+    /**
+     * @brief Computes r = a / d for an odd divisor d that is known to divide a exactly.
+     *
+     * Multiplies by the inverse of d modulo 2^64 instead of dividing, so each limb costs
+     * two multiplications. r may alias a.
+     */
+    void divideExact1(Limb *r, const Limb *a, std::size_t n, Limb d) {
+        // Newton iteration for d^-1 mod 2^64; each step doubles the number of correct bits
+        Limb inverse = d;
+        for (int i = 0; i < 5; ++i) {
+            inverse *= 2 - d * inverse;
+        }
+
+        Limb borrow = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            Limb digit = a[i];
+            Limb x = digit - borrow;
+            borrow = digit < borrow ? 1 : 0;
+            Limb q = x * inverse;
+            r[i] = q;
+            borrow += static_cast<Limb>((static_cast<DoubleLimb>(q) * d) >> 64);
+        }
+    }
+
+    /**
+     * @brief Schoolbook long division (Knuth, TAOCP vol. 2, Algorithm 4.3.1 D).
+     *
+     * The divisor is normalised so its top bit is set, which keeps every two-by-one
+     * quotient estimate within two of the true digit; the estimate is refined with the
+     * second divisor limb and corrected by at most one add-back.
+     *
+     * @param q Quotient output of an - dn + 1 limbs.
+     * @param r Remainder output of dn limbs.
+     * @param a Dividend of an >= dn limbs.
+     * @param d Divisor of dn limbs with a non-zero top limb.
+     */
+    void divideBasecase(Limb *q, Limb *r, const Limb *a, std::size_t an, const Limb *d, std::size_t dn) {
+        if (dn == 1) {
+            r[0] = divide1(q, a, an, d[0]);
+            return;
+        }
+
+        // Normalise so the top divisor limb has its high bit set
+        unsigned shift = static_cast<unsigned>(__builtin_clzll(d[dn - 1]));
+        BigIntArena::Scope scratch;
+        Limb *v = scratch.allocate(dn);
+        Limb *u = scratch.allocate(an + 1);
+        shiftLeft(v, d, dn, shift);
+        u[an] = shiftLeft(u, a, an, shift);
+
+        const DoubleLimb base = static_cast<DoubleLimb>(1) << 64;
+        Limb top = v[dn - 1];
+        Limb second = v[dn - 2];
+        for (std::size_t j = an - dn + 1; j-- > 0;) {
+            // Estimate the quotient digit from the top two limbs of the current window
+            DoubleLimb numerator = (static_cast<DoubleLimb>(u[j + dn]) << 64) | u[j + dn - 1];
+            DoubleLimb qhat = u[j + dn] >= top ? base - 1 : numerator / top;
+            DoubleLimb rhat = numerator - qhat * top;
+            while (rhat < base && qhat * second > ((rhat << 64) | u[j + dn - 2])) {
+                --qhat;
+                rhat += top;
+            }
+
+            // Multiply and subtract; an overshoot by one shows up as a borrow
+            Limb borrow = subtractMultiply1(u + j, v, dn, static_cast<Limb>(qhat));
+            Limb high = u[j + dn];
+            u[j + dn] = high - borrow;
+            if (high < borrow) {
+                --qhat;
+                u[j + dn] += addN(u + j, u + j, v, dn);
+            }
+            q[j] = static_cast<Limb>(qhat);
+        }
+
+        // Undo the normalisation on the remainder
+        shiftRight(r, u, dn, shift);
+    }
+
+    /**
+     * @brief Schoolbook product of an an-limb and a bn-limb operand.
+     * @param r Output of an + bn limbs; must not overlap a or b.
+     */
+    void multiplyBasecase(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+        // Keep the longer operand in the inner loop
+        if (an < bn) {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+        r[an] = multiply1(r, a, an, b[0]);
+        for (std::size_t j = 1; j < bn; ++j) {
+            r[an + j] = addMultiply1(r + j, a, an, b[j]);
+        }
+    }
+
+    /**
+     * @brief Number of scratch limbs multiplyKaratsuba needs for n-limb operands.
+     * @param n The operand size in limbs.
+     * @return The scratch size in limbs.
+     */
+    std::size_t karatsubaScratchSize(std::size_t n) {
+        if (n < KARATSUBA_THRESHOLD) {
+            return 0;
+        }
+        std::size_t low = (n + 1) / 2;
+        return 4 * low + std::max(karatsubaScratchSize(low), 2 * low + 1);
+    }
+
+    /**
+     * @brief Karatsuba product of two n-limb operands, falling back to the basecase below
+     *        KARATSUBA_THRESHOLD.
+     *
+     * Uses the subtractive form z1 = z0 + z2 - (a0 - a1)(b0 - b1), so no half ever grows
+     * beyond its limb count and all temporaries live in the caller's scratch space.
+     *
+     * @param r Output of 2n limbs; must not overlap a, b or scratch.
+     * @param scratch At least karatsubaScratchSize(n) limbs.
+     */
+    void multiplyKaratsuba(Limb *r, const Limb *a, const Limb *b, std::size_t n, Limb *scratch) {
+        if (n < KARATSUBA_THRESHOLD) {
+            multiplyBasecase(r, a, n, b, n);
+            return;
+        }
+
+        // Split into a low half of `low` limbs and a high half of `high` <= low limbs
+        std::size_t low = (n + 1) / 2;
+        std::size_t high = n - low;
+
+        Limb *diffA = scratch;
+        Limb *diffB = scratch + low;
+        Limb *middle = scratch + 2 * low;
+        Limb *next = scratch + 4 * low;
+
+        bool negativeA = absoluteDifference(diffA, a, low, a + low, high);
+        bool negativeB = absoluteDifference(diffB, b, low, b + low, high);
+
+        if (n >= PARALLEL_THRESHOLD && BigIntThreadPool::running()) {
+            // The three products write disjoint limbs, so each only needs its own scratch
+            BigIntArena::Scope scope;
+            std::size_t size = karatsubaScratchSize(low);
+            Limb *nextHigh = scope.allocate(size);
+            Limb *nextMiddle = scope.allocate(size);
+            BigIntThreadPool::TaskGroup tasks;
+            tasks.spawn([=] { multiplyKaratsuba(r + 2 * low, a + low, b + low, high, nextHigh); });
+            tasks.spawn([=] { multiplyKaratsuba(middle, diffA, diffB, low, nextMiddle); });
+            multiplyKaratsuba(r, a, b, low, next);
+            tasks.wait();
+        } else {
+            multiplyKaratsuba(r, a, b, low, next);  // z0 = a0 * b0
+            multiplyKaratsuba(r + 2 * low, a + low, b + low, high, next);  // z2 = a1 * b1
+            multiplyKaratsuba(middle, diffA, diffB, low, next);  // |a0 - a1| * |b0 - b1|
+        }
+
+        // z1 = z0 + z2 - (a0 - a1)(b0 - b1), built in the now free recursion scratch
+        combineKaratsuba(r, middle, low, high, negativeA == negativeB, next);
+    }
+
+    /**
+     * @brief Schoolbook square of an n-limb operand.
+     *
+     * Each cross product a[i] * a[j] with i < j is computed once and doubled with a shift,
+     * then the diagonal squares are added, roughly halving the multiplications.
+     *
+     * @param r Output of 2n limbs; must not overlap a.
+     */
+    void squareBasecase(Limb *r, const Limb *a, std::size_t n) {
+        // Off-diagonal triangle, row i added at offset 2i + 1
+        r[0] = 0;
+        r[2 * n - 1] = 0;
+        if (n > 1) {
+            r[n] = multiply1(r + 1, a + 1, n - 1, a[0]);
+            for (std::size_t i = 1; i + 1 < n; ++i) {
+                r[n + i] = addMultiply1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+            }
+        }
+
+        // Double the triangle; it is below B^(2n) / 2 so nothing shifts out
+        for (std::size_t i = 2 * n; i-- > 1;) {
+            r[i] = (r[i] << 1) | (r[i - 1] >> 63);
+        }
+        r[0] <<= 1;
+
+        // Add the diagonal squares a[i]^2 at limb 2i
+        Limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            DoubleLimb square = static_cast<DoubleLimb>(a[i]) * a[i];
+            DoubleLimb low = static_cast<DoubleLimb>(r[2 * i]) + static_cast<Limb>(square) + carry;
+            r[2 * i] = static_cast<Limb>(low);
+            DoubleLimb high = static_cast<DoubleLimb>(r[2 * i + 1]) + static_cast<Limb>(square >> 64) +
+                              static_cast<Limb>(low >> 64);
+            r[2 * i + 1] = static_cast<Limb>(high);
+            carry = static_cast<Limb>(high >> 64);
+        }
+    }
+
+    /**
+     * @brief Karatsuba square of an n-limb operand: three half-size squares, the middle one
+     *        of |a0 - a1|, which is always subtracted.
+     * @param r Output of 2n limbs; must not overlap a or scratch.
+     * @param scratch At least karatsubaScratchSize(n) limbs.
+     */
+    void squareKaratsuba(Limb *r, const Limb *a, std::size_t n, Limb *scratch) {
+        if (n < KARATSUBA_THRESHOLD) {
+            squareBasecase(r, a, n);
+            return;
+        }
+
+        std::size_t low = (n + 1) / 2;
+        std::size_t high = n - low;
+
+        // Same scratch layout as multiplyKaratsuba, so karatsubaScratchSize covers both
+        Limb *diff = scratch;
+        Limb *middle = scratch + 2 * low;
+        Limb *next = scratch + 4 * low;
+
+        absoluteDifference(diff, a, low, a + low, high);
+
+        if (n >= PARALLEL_THRESHOLD && BigIntThreadPool::running()) {
+            BigIntArena::Scope scope;
+            std::size_t size = karatsubaScratchSize(low);
+            Limb *nextHigh = scope.allocate(size);
+            Limb *nextMiddle = scope.allocate(size);
+            BigIntThreadPool::TaskGroup tasks;
+            tasks.spawn([=] { squareKaratsuba(r + 2 * low, a + low, high, nextHigh); });
+            tasks.spawn([=] { squareKaratsuba(middle, diff, low, nextMiddle); });
+            squareKaratsuba(r, a, low, next);
+            tasks.wait();
+        } else {
+            squareKaratsuba(r, a, low, next);  // z0 = a0^2
+            squareKaratsuba(r + 2 * low, a + low, high, next);  // z2 = a1^2
+            squareKaratsuba(middle, diff, low, next);  // (a0 - a1)^2
+        }
+
+        // z1 = z0 + z2 - (a0 - a1)^2
+        combineKaratsuba(r, middle, low, high, true, next);
+    }
+
+    /**
+     * @brief Toom-Cook product of a split into aParts pieces and b into bParts pieces.
+     *
+     * Supports the 3x3 (Toom-3), 3x2 (Toom-2.5) and 4x2 splits. The 3x2 product has four
+     * coefficients and is evaluated at 0, 1, -1 and infinity; the others have five and add
+     * the point -2, interpolated with Bodrato's sequence. The pointwise products recurse
+     * through multiply(), so each one picks its own algorithm by size. Passing the same
+     * operand and split twice turns every pointwise product into a square.
+     *
+     * @param r Output of an + bn limbs; must not overlap a or b.
+     */
+    void multiplyToom(Limb *r, const Limb *a, std::size_t an, std::size_t aParts,
+                      const Limb *b, std::size_t bn, std::size_t bParts) {
+        // A square splits both operands identically, so each point needs one evaluation
+        bool squaring = a == b && an == bn && aParts == bParts;
+        std::size_t k = std::max((an + aParts - 1) / aParts, (bn + bParts - 1) / bParts);
+        std::vector<std::vector<Limb>> as = split(a, an, aParts, k);
+        std::vector<std::vector<Limb>> bs = squaring ? std::vector<std::vector<Limb>>() : split(b, bn, bParts, k);
+        const std::vector<std::vector<Limb>> &bSplit = squaring ? as : bs;
+        std::size_t coefficients = aParts + bParts - 1;
+
+        // Evaluation and pointwise multiplication; the products are independent, so they
+        // run as tasks when the thread pool is enabled
+        SignedLimbs v0;
+        SignedLimbs vInf;
+        SignedLimbs v1;
+        SignedLimbs vMinus1;
+        SignedLimbs vMinus2;
+        BigIntThreadPool::TaskGroup tasks;
+        tasks.spawn([&] {
+            v0.magnitude = squaring ? squareVector(as.front()) : multiplyVectors(as.front(), bs.front());
+        });
+        tasks.spawn([&] {
+            vInf.magnitude = squaring ? squareVector(as.back()) : multiplyVectors(as.back(), bs.back());
+        });
+        tasks.spawn([&] { v1 = pointwise(as, bSplit, 1, squaring); });
+        if (coefficients == 5) {
+            tasks.spawn([&] { vMinus2 = pointwise(as, bSplit, -2, squaring); });
+        }
+        vMinus1 = pointwise(as, bSplit, -1, squaring);
+        tasks.wait();
+
+        std::vector<SignedLimbs> c(coefficients);
+        c.front() = v0;
+        c.back() = vInf;
+        if (coefficients == 4) {
+            // c2 = (v1 + v(-1)) / 2 - c0 and c1 = (v1 - v(-1)) / 2 - c3
+            c[2] = v1;
+            accumulate(c[2], vMinus1, false);
+            divideExact(c[2], 2);
+            accumulate(c[2], v0, true);
+            c[1] = v1;
+            accumulate(c[1], vMinus1, true);
+            divideExact(c[1], 2);
+            accumulate(c[1], vInf, true);
+        } else {
+            // r3 = (v(-2) - v1) / 3
+            c[3] = vMinus2;
+            accumulate(c[3], v1, true);
+            divideExact(c[3], 3);
+            // r1 = (v1 - v(-1)) / 2
+            c[1] = v1;
+            accumulate(c[1], vMinus1, true);
+            divideExact(c[1], 2);
+            // r2 = v(-1) - v0
+            c[2] = vMinus1;
+            accumulate(c[2], v0, true);
+            // r3 = (r2 - r3) / 2 + 2 * vInf
+            SignedLimbs r3 = c[2];
+            accumulate(r3, c[3], true);
+            divideExact(r3, 2);
+            accumulate(r3, vInf, false);
+            accumulate(r3, vInf, false);
+            c[3] = r3;
+            // r2 = r2 + r1 - vInf
+            accumulate(c[2], c[1], false);
+            accumulate(c[2], vInf, true);
+            // r1 = r1 - r3
+            accumulate(c[1], c[3], true);
+        }
+
+        // Recomposition: every coefficient is non-negative and fits below the product's top
+        std::size_t total = an + bn;
+        std::fill(r, r + total, 0);
+        for (std::size_t i = 0; i < coefficients; ++i) {
+            const std::vector<Limb> &m = c[i].magnitude;
+            if (!m.empty()) {
+                add(r + i * k, r + i * k, total - i * k, m.data(), m.size());
+            }
+        }
+    }
+
+    /**
+     * @brief Product of two operands of arbitrary sizes, picking the algorithm by size.
+     *
+     * Balanced operands use the schoolbook basecase, Karatsuba or Toom-3 depending on
+     * length. Moderately unbalanced ones use the 3x2 and 4x2 Toom splits, and anything
+     * more lopsided is cut into blocks the size of the shorter operand. Once the shorter
+     * operand reaches NTT_THRESHOLD the transform handles any shape directly.
+     *
+     * @param r Output of an + bn limbs; must not overlap a or b.
+     */
+    void multiply(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+        if (a == b && an == bn) {
+            square(r, a, an);
+            return;
+        }
+        if (an < bn) {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+        if (bn < KARATSUBA_THRESHOLD) {
+            multiplyBasecase(r, a, an, b, bn);
+        } else if (bn < TOOM3_THRESHOLD) {
+            if (an == bn) {
+                BigIntArena::Scope scratch;
+                multiplyKaratsuba(r, a, b, bn, scratch.allocate(karatsubaScratchSize(bn)));
+            } else {
+                multiplyBlocks(r, a, an, b, bn);
+            }
+        } else if (bn >= NTT_THRESHOLD) {
+            multiplyNtt(r, a, an, b, bn);
+        } else if (4 * an < 5 * bn) {
+            multiplyToom(r, a, an, 3, b, bn, 3);
+        } else if (4 * an < 7 * bn) {
+            multiplyToom(r, a, an, 3, b, bn, 2);
+        } else if (2 * an < 5 * bn) {
+            multiplyToom(r, a, an, 4, b, bn, 2);
+        } else {
+            multiplyBlocks(r, a, an, b, bn);
+        }
+    }
+
+    /**
+     * @brief Square of an n-limb operand, with the same size tiers as multiply() but a
+     *        squaring kernel at each of them.
+     * @param r Output of 2n limbs; must not overlap a.
+     */
+    void square(Limb *r, const Limb *a, std::size_t n) {
+        if (n < KARATSUBA_THRESHOLD) {
+            squareBasecase(r, a, n);
+        } else if (n < TOOM3_THRESHOLD) {
+            BigIntArena::Scope scratch;
+            squareKaratsuba(r, a, n, scratch.allocate(karatsubaScratchSize(n)));
+        } else if (n < NTT_THRESHOLD) {
+            multiplyToom(r, a, n, 3, a, n, 3);
+        } else {
+            multiplyNtt(r, a, n, a, n);
+        }
+    }
+
+    /**
+     * @brief Returns -m0^-1 mod 2^64 for an odd m0, the per-limb factor of Montgomery
+     *        reduction.
+     */
+    Limb montgomeryInverse(Limb m0) {
+        // Newton iteration doubles the number of correct low bits from the 3 of m0 itself
+        Limb inverse = m0;
+        for (int i = 0; i < 5; ++i) {
+            inverse *= 2 - m0 * inverse;
+        }
+        return 0 - inverse;
+    }
+
+    /**
+     * @brief Montgomery reduction r = t / B^n mod m for t < m B^n, clearing one low limb
+     *        of t per step with a multiple of m.
+     * @param r Output of n limbs, fully reduced below m.
+     * @param t Input of 2n limbs; overwritten.
+     * @param m Odd modulus of n limbs.
+     * @param inverse montgomeryInverse(m[0]).
+     */
+    void montgomeryReduce(Limb *r, Limb *t, const Limb *m, std::size_t n, Limb inverse) {
+        Limb top = 0;  // Carry out of t[2n - 1]
+        for (std::size_t i = 0; i < n; ++i) {
+            Limb carry = addMultiply1(t + i, m, n, t[i] * inverse);
+            for (std::size_t j = i + n; carry != 0 && j < 2 * n; ++j) {
+                t[j] += carry;
+                carry = t[j] < carry ? 1 : 0;
+            }
+            top += carry;
+        }
+
+        // The result (top, t[n, 2n)) is below 2m, so one subtraction reduces it
+        if (top != 0 || compare(t + n, n, m, n) >= 0) {
+            subtractN(r, t + n, m, n);
+        } else {
+            std::copy(t + n, t + 2 * n, r);
+        }
+    }
+
+    /**
+     * @brief Quotient and remainder of a by d, picking the algorithm by size.
+     *
+     * Short divisors or quotients use divideBasecase. Otherwise both operands are
+     * normalised and the quotient is produced in blocks of dn limbs, each by recursive
+     * division, so the cost is a small multiple of an dn-limb multiplication per block.
+     *
+     * @param q Quotient output of an - dn + 1 limbs.
+     * @param r Remainder output of dn limbs.
+     * @param a Dividend of an >= dn limbs.
+     * @param d Divisor of dn limbs with a non-zero top limb.
+     */
+    void divide(Limb *q, Limb *r, const Limb *a, std::size_t an, const Limb *d, std::size_t dn) {
+        if (dn < DIVIDE_THRESHOLD || an - dn < DIVIDE_THRESHOLD) {
+            divideBasecase(q, r, a, an, d, dn);
+            return;
+        }
+
+        unsigned shift = static_cast<unsigned>(__builtin_clzll(d[dn - 1]));
+        BigIntArena::Scope scratch;
+        Limb *v = scratch.allocate(dn);
+        Limb *u = scratch.allocate(an + 1);
+        shiftLeft(v, d, dn, shift);
+        u[an] = shiftLeft(u, a, an, shift);
+
+        // Walk down the dividend one block of at most dn quotient limbs at a time; each
+        // window's top dn limbs are the previous block's remainder, so no overflow limb.
+        std::size_t position = an + 1 - dn;
+        while (position > 0) {
+            std::size_t block = std::min(dn, position);
+            position -= block;
+            divideRecursive(q + position, u + position, dn, block, v);
+        }
+
+        shiftRight(r, u, dn, shift);
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef BIGINT_KERNELS_H
+#define BIGINT_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Low-level kernels that operate on raw little-endian limb arrays.
+ *
+ * These routines do no normalisation; callers own every output buffer and must size
+ * it as documented. Temporaries come from the current thread's BigIntArena, apart from
+ * the Toom evaluation points. BigInt builds its operators on top of them.
+ */
+namespace bigint_kernels {
+    using Limb = std::uint64_t;
+
+    /**
+     * @brief Operand size (in limbs) from which Karatsuba beats the schoolbook basecase.
+     */
+    const std::size_t KARATSUBA_THRESHOLD = 32;
+
+    /**
+     * @brief Operand size (in limbs) from which Toom-3 beats Karatsuba.
+     */
+    const std::size_t TOOM3_THRESHOLD = 1024;
+
+    /**
+     * @brief Size (in limbs) of the shorter operand from which the NTT beats Toom-3.
+     */
+    const std::size_t NTT_THRESHOLD = 4096;
+
+    /**
+     * @brief Divisor and quotient size (in limbs) from which recursive division beats
+     *        the schoolbook basecase.
+     */
+    const std::size_t DIVIDE_THRESHOLD = 128;
+
+    /**
+     * @brief Size (in limbs) from which decimal conversion splits the value recursively
+     *        instead of handling 19 digits per single-limb step.
+     */
+    const std::size_t RADIX_THRESHOLD = 32;
+
+    /**
+     * @brief Size (in limbs) from which the GCD recurses on half-size operands instead
+     *        of running Lehmer steps over the full length.
+     */
+    const std::size_t HGCD_THRESHOLD = 160;
+
+    /**
+     * @brief Operand size (in limbs) from which a multiplication hands its independent
+     *        sub-products to the BigIntThreadPool, when one is running.
+     */
+    const std::size_t PARALLEL_THRESHOLD = 512;
+
+    int compare(const Limb *a, std::size_t an, const Limb *b, std::size_t bn);
+
+    Limb addN(Limb *r, const Limb *a, const Limb *b, std::size_t n);
+
+    Limb add(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn);
+
+    Limb subtractN(Limb *r, const Limb *a, const Limb *b, std::size_t n);
+
+    Limb subtract(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn);
+
+    Limb multiply1(Limb *r, const Limb *a, std::size_t n, Limb m);
+
+    Limb addMultiply1(Limb *r, const Limb *a, std::size_t n, Limb m);
+
+    Limb subtractMultiply1(Limb *r, const Limb *a, std::size_t n, Limb m);
+
+    Limb shiftLeft(Limb *r, const Limb *a, std::size_t n, unsigned shift);
+
+    Limb shiftRight(Limb *r, const Limb *a, std::size_t n, unsigned shift);
+
+    Limb reciprocal(Limb d);
+
+    Limb divide1(Limb *q, const Limb *a, std::size_t n, Limb d);
+
+    Limb remainder1(const Limb *a, std::size_t n, Limb d);
+
+    void divideExact1(Limb *r, const Limb *a, std::size_t n, Limb d);
+
+    void divideBasecase(Limb *q, Limb *r, const Limb *a, std::size_t an, const Limb *d, std::size_t dn);
+
+    void divide(Limb *q, Limb *r, const Limb *a, std::size_t an, const Limb *d, std::size_t dn);
+
+    void multiplyBasecase(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn);
+
+    void squareBasecase(Limb *r, const Limb *a, std::size_t n);
+
+    std::size_t karatsubaScratchSize(std::size_t n);
+
+    void multiplyKaratsuba(Limb *r, const Limb *a, const Limb *b, std::size_t n, Limb *scratch);
+
+    void squareKaratsuba(Limb *r, const Limb *a, std::size_t n, Limb *scratch);
+
+    void multiplyToom(Limb *r, const Limb *a, std::size_t an, std::size_t aParts,
+                      const Limb *b, std::size_t bn, std::size_t bParts);
+
+    void multiplyNtt(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn);
+
+    void multiply(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn);
+
+    void square(Limb *r, const Limb *a, std::size_t n);
+
+    Limb montgomeryInverse(Limb m0);
+
+    void montgomeryReduce(Limb *r, Limb *t, const Limb *m, std::size_t n, Limb inverse);
+
+    std::size_t decimalDigitsBound(std::size_t n);
+
+    std::size_t fromDecimal(Limb *r, const char *digits, std::size_t n);
+
+    void toDecimal(char *out, std::size_t width, const Limb *a, std::size_t n);
+}
+
+#endif // BIGINT_KERNELS_H
@@ -0,0 +1,452 @@
+#include "BigIntModular.h"
+#include <algorithm>
+#include <stdexcept>
+#include "BigIntKernels.h"
+
+//========== Exponentiation Helpers ==========
+
+namespace {
+    using Limb = BigInt::Limb;
+
+    /**
+     * @brief Number of significant bits in an exponent of n limbs with a non-zero top limb.
+     */
+    size_t bitLength(const Limb *e, size_t n) {
+        return n == 0 ? 0 : 64 * n - static_cast<size_t>(__builtin_clzll(e[n - 1]));
+    }
+
+    bool testBit(const Limb *e, size_t bit) {
+        return (e[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    /**
+     * @brief Window width for sliding-window exponentiation, trading the 2^(k-1) table
+     *        entries against one multiplication per k exponent bits.
+     */
+    size_t windowSize(size_t bits) {
+        const size_t limits[] = {24, 80, 240, 672, 1792};
+        size_t k = 1;
+        for (size_t limit: limits) {
+            if (bits > limit) {
+                ++k;
+            }
+        }
+        return k;
+    }
+
+    /**
+     * @brief Left-to-right sliding-window exponentiation base^e for e > 0.
+     *
+     * Zero bits cost one squaring each; every run of up to k bits that starts and ends
+     * with a one costs its squarings plus one multiplication by a precomputed odd power.
+     *
+     * @param multiply Callable returning the product of two values; receives the same
+     *                 object twice when squaring.
+     */
+    template <typename Value, typename Multiply>
+    Value slidingWindowPower(const Value &base, const Limb *e, size_t n, Multiply multiply) {
+        size_t bits = bitLength(e, n);
+        size_t k = windowSize(bits);
+
+        // Odd powers base^1, base^3, ..., base^(2^k - 1)
+        std::vector<Value> table(1, base);
+        if (k > 1) {
+            Value baseSquared = multiply(base, base);
+            for (size_t i = 1; i < (size_t(1) << (k - 1)); ++i) {
+                table.push_back(multiply(table.back(), baseSquared));
+            }
+        }
+
+        Value result = base;
+        bool started = false;
+        size_t i = bits;
+        while (i > 0) {
+            if (!testBit(e, i - 1)) {
+                result = multiply(result, result);
+                --i;
+                continue;
+            }
+
+            // Take the longest window of at most k bits ending in a one
+            size_t low = i > k ? i - k : 0;
+            while (!testBit(e, low)) {
+                ++low;
+            }
+            size_t window = 0;
+            for (size_t bit = i; bit-- > low;) {
+                window = 2 * window + (testBit(e, bit) ? 1 : 0);
+                if (started) {
+                    result = multiply(result, result);
+                }
+            }
+            result = started ? multiply(result, table[window / 2]) : table[window / 2];
+            started = true;
+            i = low;
+        }
+        return result;
+    }
+}
+
+//========== Constructors ==========
+
+/**
+ * @brief Prepares Montgomery arithmetic modulo an odd positive modulus.
+ * @param modulus The modulus.
+ * @throws std::invalid_argument If the modulus is not odd and positive.
+ */
+MontgomeryContext::MontgomeryContext(const BigInt &modulus) : mod(modulus), inverse(0) {
+    if (modulus.isNegative || modulus.isZero() || (modulus.limbs[0] & 1) == 0) {
+        throw std::invalid_argument("Montgomery modulus must be odd and positive");
+    }
+    m.assign(modulus.limbs.begin(), modulus.limbs.end());
+    inverse = bigint_kernels::montgomeryInverse(m[0]);
+
+    // R^2 mod m with R = B^n, from one division of B^2n
+    BigInt r;
+    r.limbs.assign(2 * m.size() + 1, 0);
+    r.limbs.back() = 1;
+    rSquared = toResidue(r % mod);
+}
+
+//========== Accessors ==========
+
+/**
+ * @brief Returns the modulus of the context.
+ * @return The modulus.
+ */
+const BigInt &MontgomeryContext::modulus() const {
+    return mod;
+}
+
+//========== Conversions ==========
+
+/**
+ * @brief Converts a value to Montgomery form x R mod m.
+ * @param x Any value; it is reduced into [0, m) first.
+ * @return The Montgomery form of x.
+ */
+BigInt MontgomeryContext::toMontgomery(const BigInt &x) const {
+    std::vector<Limb> scratch;
+    Residue result;
+    multiplyInto(result, toResidue(x), rSquared, scratch);
+    return toBigInt(result);
+}
+
+/**
+ * @brief Converts a value out of Montgomery form.
+ * @param x A Montgomery form in [0, m).
+ * @return The ordinary residue x R^-1 mod m.
+ */
+BigInt MontgomeryContext::fromMontgomery(const BigInt &x) const {
+    std::vector<Limb> scratch;
+    Residue one(m.size(), 0);
+    one[0] = 1;
+    Residue result;
+    multiplyInto(result, toResidue(x), one, scratch);
+    return toBigInt(result);
+}
+
+//========== Arithmetic ==========
+
+/**
+ * @brief Montgomery product a b R^-1 mod m of two values in Montgomery form.
+ * @param a The first factor, in [0, m).
+ * @param b The second factor, in [0, m).
+ * @return The Montgomery form of the product of the underlying residues.
+ */
+BigInt MontgomeryContext::multiply(const BigInt &a, const BigInt &b) const {
+    std::vector<Limb> scratch;
+    Residue result;
+    multiplyInto(result, toResidue(a), toResidue(b), scratch);
+    return toBigInt(result);
+}
+
+/**
+ * @brief Computes base^exponent mod m with sliding-window exponentiation, keeping every
+ *        intermediate in Montgomery form.
+ * @param base The base; may be negative or larger than the modulus.
+ * @param exponent The non-negative exponent.
+ * @return The modular power, in [0, m).
+ * @throws std::invalid_argument If the exponent is negative.
+ */
+BigInt MontgomeryContext::powMod(const BigInt &base, const BigInt &exponent) const {
+    if (exponent.isNegative) {
+        throw std::invalid_argument("Negative exponent is not supported for powMod");
+    }
+    if (exponent.isZero()) {
+        return BigInt(1) % mod;
+    }
+
+    std::vector<Limb> scratch;
+    Residue montgomeryBase;
+    multiplyInto(montgomeryBase, toResidue(base), rSquared, scratch);
+
+    Residue power = slidingWindowPower(montgomeryBase, exponent.limbs.data(), exponent.limbs.size(),
+                                       [&](const Residue &a, const Residue &b) {
+                                           Residue product;
+                                           multiplyInto(product, a, b, scratch);
+                                           return product;
+                                       });
+
+    // Leave Montgomery form by multiplying with 1
+    Residue one(m.size(), 0);
+    one[0] = 1;
+    Residue result;
+    multiplyInto(result, power, one, scratch);
+    return toBigInt(result);
+}
+
+//========== Private Methods ==========
+
+/**
+ * @brief Reduces a value into [0, m) and pads its limbs to the modulus size.
+ * @param x Any value.
+ * @return The residue as exactly n limbs.
+ */
+MontgomeryContext::Residue MontgomeryContext::toResidue(const BigInt &x) const {
+    const BigInt *reduced = &x;
+    BigInt remainder;
+    if (x.isNegative || bigint_kernels::compare(x.limbs.data(), x.limbs.size(), m.data(), m.size()) >= 0) {
+        remainder = x % mod;
+        if (remainder.isNegative) {
+            remainder += mod;
+        }
+        reduced = &remainder;
+    }
+    Residue residue(m.size(), 0);
+    std::copy(reduced->limbs.begin(), reduced->limbs.end(), residue.begin());
+    return residue;
+}
+
+/**
+ * @brief Builds a BigInt from an n-limb residue.
+ * @param x The residue.
+ * @return The value, normalised.
+ */
+BigInt MontgomeryContext::toBigInt(const Residue &x) const {
+    BigInt result;
+    result.limbs.resize(x.size());
+    std::copy(x.begin(), x.end(), result.limbs.begin());
+    result.removeLeadingZeros();
+    return result;
+}
+
+/**
+ * @brief Montgomery product r = a b R^-1 mod m of two n-limb residues; squares when a
+ *        and b are the same object.
+ * @param r Receives the product; may be a or b.
+ * @param scratch Reused buffer for the 2n-limb double-width product.
+ */
+void MontgomeryContext::multiplyInto(Residue &r, const Residue &a, const Residue &b,
+                                     std::vector<Limb> &scratch) const {
+    size_t n = m.size();
+    scratch.resize(2 * n);
+    if (&a == &b) {
+        bigint_kernels::square(scratch.data(), a.data(), n);
+    } else {
+        bigint_kernels::multiply(scratch.data(), a.data(), n, b.data(), n);
+    }
+    r.resize(n);
+    bigint_kernels::montgomeryReduce(r.data(), scratch.data(), m.data(), n, inverse);
+}
+
+//========== Barrett Reduction ==========
+
+/**
+ * @brief Prepares reduction modulo a positive modulus by computing mu = floor(B^2n / m),
+ *        which is only needed below DIVIDE_THRESHOLD limbs.
+ * @param modulus The modulus.
+ * @throws std::invalid_argument If the modulus is not positive.
+ */
+BarrettReducer::BarrettReducer(const BigInt &modulus) : mod(modulus) {
+    if (modulus.isNegative || modulus.isZero()) {
+        throw std::invalid_argument("Barrett modulus must be positive");
+    }
+    size_t n = modulus.limbs.size();
+    if (n >= bigint_kernels::DIVIDE_THRESHOLD) {
+        return;
+    }
+    std::vector<Limb> power(2 * n + 1, 0);
+    power.back() = 1;
+    std::vector<Limb> remainder(n);
+    mu.resize(n + 2);
+    bigint_kernels::divide(mu.data(), remainder.data(), power.data(), power.size(), modulus.limbs.data(), n);
+    while (mu.back() == 0) {
+        mu.pop_back();
+    }
+}
+
+/**
+ * @brief Returns the modulus of the reducer.
+ * @return The modulus.
+ */
+const BigInt &BarrettReducer::modulus() const {
+    return mod;
+}
+
+/**
+ * @brief Reduces a value modulo the modulus.
+ * @param x Any value; inputs of more than 2n limbs fall back to a division.
+ * @return x mod m, in [0, m).
+ */
+BigInt BarrettReducer::reduce(const BigInt &x) const {
+    std::vector<Limb> scratch;
+    BigInt result;
+    reduceInto(result, x, scratch);
+    return result;
+}
+
+/**
+ * @brief Reduces count values, sharing one scratch buffer across all of them.
+ * @param values The inputs.
+ * @param results Receives the reduced values; may be the same array as values.
+ * @param count Number of values.
+ */
+void BarrettReducer::reduce(const BigInt *values, BigInt *results, size_t count) const {
+    std::vector<Limb> scratch;
+    for (size_t i = 0; i < count; ++i) {
+        reduceInto(results[i], values[i], scratch);
+    }
+}
+
+/**
+ * @brief Reduces every value of a vector.
+ * @param values The inputs.
+ * @return The reduced values, in the same order.
+ */
+std::vector<BigInt> BarrettReducer::reduce(const std::vector<BigInt> &values) const {
+    std::vector<BigInt> results(values.size());
+    reduce(values.data(), results.data(), values.size());
+    return results;
+}
+
+/**
+ * @brief Modular product of two values.
+ * @param a The first factor; reduced residues keep the product within one Barrett step.
+ * @param b The second factor.
+ * @return a b mod m, in [0, m).
+ */
+BigInt BarrettReducer::multiply(const BigInt &a, const BigInt &b) const {
+    return reduce(a * b);
+}
+
+/**
+ * @brief Barrett reduction (HAC 14.42) of x into result.
+ *
+ * With q = floor(floor(|x| / B^(n-1)) mu / B^(n+1)), the difference |x| - q m lies in
+ * [0, 3m). Both products are truncated to the limbs that matter, which leaves about one
+ * n-by-n schoolbook product of work and widens the range to [0, 4m); that still fits in
+ * n + 1 limbs, so the difference is computed modulo B^(n+1) and corrected with at most
+ * three subtractions. From DIVIDE_THRESHOLD limbs on,
+ * recursive division already runs at the cost of a few multiplications and is faster
+ * than two full products, so larger moduli and inputs above B^2n use operator%.
+ *
+ * @param result Receives x mod m in [0, m); may be x.
+ * @param x The value to reduce.
+ * @param scratch Reused buffer for the two products.
+ */
+void BarrettReducer::reduceInto(BigInt &result, const BigInt &x, std::vector<Limb> &scratch) const {
+    const Limb *m = mod.limbs.data();
+    size_t n = mod.limbs.size();
+    size_t xn = x.limbs.size();
+    if (xn > 2 * n || n >= bigint_kernels::DIVIDE_THRESHOLD) {
+        result = x % mod;
+        if (result.isNegative) {
+            result += mod;
+        }
+        return;
+    }
+    if (bigint_kernels::compare(x.limbs.data(), xn, m, n) < 0) {
+        result = x;
+        if (result.isNegative) {
+            result += mod;
+        }
+        return;
+    }
+
+    // q3 = floor(floor(|x| / B^(n-1)) mu / B^(n+1)), and p = q3 m modulo B^(n+1)
+    const Limb *q1 = x.limbs.data() + (n - 1);
+    size_t q1n = xn - n + 1;
+    size_t mun = mu.size();
+    size_t q2n = q1n + mun;
+    size_t q3n = q2n - (n + 1);
+    scratch.assign(q2n + n + 1, 0);
+    Limb *q2 = scratch.data();
+    Limb *p = q2 + q2n;
+    // Only the partial products that reach limb n - 1 of q2 can carry into q3;
+    // dropping the rest lowers q3 by at most one, costing one more subtraction
+    for (size_t i = 0; i < q1n; ++i) {
+        size_t j = i + 1 < n ? n - 1 - i : 0;
+        q2[i + mun] = bigint_kernels::addMultiply1(q2 + i + j, mu.data() + j, mun - j, q1[i]);
+    }
+    // Rows of q3 m above limb n are never needed
+    for (size_t i = 0; i < q3n && i <= n; ++i) {
+        size_t length = std::min(n, n + 1 - i);
+        Limb carry = bigint_kernels::addMultiply1(p + i, m, length, q2[n + 1 + i]);
+        if (i + length <= n) {
+            p[i + length] += carry;
+        }
+    }
+
+    // r = (|x| - p) mod B^(n+1), which is the exact difference since it is below 4m
+    bool negative = x.isNegative;
+    LimbVector r(n + 1);
+    std::copy(x.limbs.begin(), x.limbs.begin() + std::min(xn, n + 1), r.begin());
+    bigint_kernels::subtractN(r.data(), r.data(), p, n + 1);
+    size_t rn = n + 1;
+    while (rn > 0 && r[rn - 1] == 0) {
+        --rn;
+    }
+    while (bigint_kernels::compare(r.data(), rn, m, n) >= 0) {
+        bigint_kernels::subtract(r.data(), r.data(), rn, m, n);
+        while (rn > 0 && r[rn - 1] == 0) {
+            --rn;
+        }
+    }
+    r.resize(rn);
+
+    result.limbs = std::move(r);
+    result.isNegative = false;
+    if (negative && rn > 0) {
+        // m - r for a negative input
+        LimbVector complement(n);
+        bigint_kernels::subtract(complement.data(), m, n, result.limbs.data(), rn);
+        result.limbs = std::move(complement);
+        result.removeLeadingZeros();
+    }
+}
+
+//========== Modular Exponentiation ==========
+
+/**
+ * @brief Computes base^exponent mod modulus, in [0, modulus).
+ * @param base The base; may be negative or larger than the modulus.
+ * @param exponent The non-negative exponent.
+ * @param modulus The positive modulus.
+ * @return The modular power.
+ * @throws std::invalid_argument If the exponent is negative or the modulus is not positive.
+ */
+BigInt powMod(const BigInt &base, const BigInt &exponent, const BigInt &modulus) {
+    if (modulus.isNegative || modulus.isZero()) {
+        throw std::invalid_argument("powMod modulus must be positive");
+    }
+    if (exponent.isNegative) {
+        throw std::invalid_argument("Negative exponent is not supported for powMod");
+    }
+    if ((modulus.limbs[0] & 1) != 0) {
+        return MontgomeryContext(modulus).powMod(base, exponent);
+    }
+
+    // Even modulus: reduce with a division after every step
+    BigInt reducedBase = base % modulus;
+    if (reducedBase.isNegative) {
+        reducedBase += modulus;
+    }
+    if (exponent.isZero()) {
+        return BigInt(1) % modulus;
+    }
+    return slidingWindowPower(reducedBase, exponent.limbs.data(), exponent.limbs.size(),
+                              [&](const BigInt &a, const BigInt &b) {
+                                  return (&a == &b ? a.square() : a * b) % modulus;
+                              });
+}
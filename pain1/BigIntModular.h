@@ -0,0 +1,140 @@
+#ifndef BIGINT_MODULAR_H
+#define BIGINT_MODULAR_H
+
+#include <vector>
+#include "BigInt.h"
+
+/**
+ * @brief Montgomery arithmetic modulo a fixed odd modulus.
+ *
+ * Setting up a context computes the per-limb inverse and R^2 mod m (R = 2^(64n) for an
+ * n-limb modulus) once, so repeated operations under the same modulus skip that work.
+ * Values passed to multiply() are in Montgomery form x R mod m, as produced by
+ * toMontgomery(); powMod() takes and returns ordinary residues.
+ */
+class MontgomeryContext {
+public:
+    //=================== Constructors ===================
+    /**
+     * @brief Prepares Montgomery arithmetic modulo an odd positive modulus.
+     * @param modulus The modulus.
+     * @throws std::invalid_argument If the modulus is not odd and positive.
+     */
+    explicit MontgomeryContext(const BigInt &modulus);
+
+    //=================== Accessors ===================
+    const BigInt &modulus() const;
+
+    //=================== Conversions ===================
+    BigInt toMontgomery(const BigInt &x) const;
+
+    BigInt fromMontgomery(const BigInt &x) const;
+
+    //=================== Arithmetic ===================
+    BigInt multiply(const BigInt &a, const BigInt &b) const;
+
+    BigInt powMod(const BigInt &base, const BigInt &exponent) const;
+
+private:
+    using Limb = BigInt::Limb;
+    using Residue = std::vector<Limb>;
+
+    BigInt mod;
+    std::vector<Limb> m;
+    Limb inverse;
+    Residue rSquared;
+
+    Residue toResidue(const BigInt &x) const;
+
+    BigInt toBigInt(const Residue &x) const;
+
+    void multiplyInto(Residue &r, const Residue &a, const Residue &b, std::vector<Limb> &scratch) const;
+};
+
+/**
+ * @brief Barrett reduction modulo a fixed positive modulus.
+ *
+ * The constructor precomputes mu = floor(B^2n / m) for an n-limb modulus (B = 2^64), so
+ * each reduction of a value below B^2n, which includes every product of two reduced
+ * residues, costs two truncated multiplications and a few subtractions instead of a
+ * division. Moduli of DIVIDE_THRESHOLD limbs or more use the recursive division, which
+ * is faster there. Results are in [0, m) whatever the sign of the input.
+ */
+class BarrettReducer {
+public:
+    //=================== Constructors ===================
+    /**
+     * @brief Prepares reduction modulo a positive modulus.
+     * @param modulus The modulus.
+     * @throws std::invalid_argument If the modulus is not positive.
+     */
+    explicit BarrettReducer(const BigInt &modulus);
+
+    //=================== Accessors ===================
+    const BigInt &modulus() const;
+
+    //=================== Reduction ===================
+    BigInt reduce(const BigInt &x) const;
+
+    void reduce(const BigInt *values, BigInt *results, std::size_t count) const;
+
+    std::vector<BigInt> reduce(const std::vector<BigInt> &values) const;
+
+    BigInt multiply(const BigInt &a, const BigInt &b) const;
+
+private:
+    using Limb = BigInt::Limb;
+
+    BigInt mod;
+    std::vector<Limb> mu;
+
+    void reduceInto(BigInt &result, const BigInt &x, std::vector<Limb> &scratch) const;
+};
+
+/**
+ * @brief Computes base^exponent mod modulus, in [0, modulus).
+ *
+ * Odd moduli use a MontgomeryContext; even ones reduce with operator% after each step.
+ * Both use sliding-window exponentiation.
+ *
+ * @param base The base; may be negative or larger than the modulus.
+ * @param exponent The non-negative exponent.
+ * @param modulus The positive modulus.
+ * @return The modular power.
+ * @throws std::invalid_argument If the exponent is negative or the modulus is not positive.
+ */
+BigInt powMod(const BigInt &base, const BigInt &exponent, const BigInt &modulus);
+
+/**
+ * @brief Greatest common divisor of a and b.
+ *
+ * Uses Lehmer's algorithm on the leading 63 bits below HGCD_THRESHOLD limbs and the
+ * subquadratic half-GCD above it, so no step divides at full precision unless a
+ * quotient is too large for a single limb.
+ *
+ * @param a The first operand; its sign is ignored.
+ * @param b The second operand; its sign is ignored.
+ * @return The non-negative GCD, which is zero only when both operands are.
+ */
+BigInt gcd(const BigInt &a, const BigInt &b);
+
+/**
+ * @brief Extended GCD: finds g = gcd(a, b) and x, y with a x + b y = g.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param x Receives the cofactor of a; when b != 0 it has the sign of a and |x| < |b| / g.
+ * @param y Receives the cofactor of b.
+ * @return The non-negative GCD.
+ */
+BigInt extendedGcd(const BigInt &a, const BigInt &b, BigInt &x, BigInt &y);
+
+/**
+ * @brief Inverse of a modulo a positive modulus.
+ * @param a The value to invert; may be negative or larger than the modulus.
+ * @param modulus The positive modulus.
+ * @return The x in [0, modulus) with a x = 1 mod modulus.
+ * @throws std::invalid_argument If the modulus is not positive or a is not coprime to it.
+ */
+BigInt modInverse(const BigInt &a, const BigInt &modulus);
+
+#endif // BIGINT_MODULAR_H
@@ -0,0 +1,271 @@
+#include "BigIntKernels.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "BigIntArena.h"
+#include "BigIntThreadPool.h"
+
+namespace bigint_kernels {
+    namespace {
+        using DoubleLimb = unsigned __int128;
+
+        /**
+         * @brief Arithmetic modulo an NTT prime below 2^62, using Montgomery reduction
+         *        with R = 2^64 for the multiplications.
+         *
+         * Plain residues multiplied by a value in Montgomery form (x * R mod p) come back
+         * as plain residues, which is how twiddle factors are applied.
+         */
+        class MontgomeryField {
+        public:
+            MontgomeryField(Limb modulus, Limb generator) : p(modulus), g(generator) {
+                // -p^-1 mod 2^64 by Newton iteration
+                Limb inverse = p;
+                for (int i = 0; i < 5; ++i) {
+                    inverse *= 2 - p * inverse;
+                }
+                negativeInverse = 0 - inverse;
+                Limb r = static_cast<Limb>((static_cast<DoubleLimb>(1) << 64) % p);
+                rSquared = static_cast<Limb>(static_cast<DoubleLimb>(r) * r % p);
+            }
+
+            Limb modulus() const { return p; }
+
+            Limb multiply(Limb a, Limb b) const {
+                DoubleLimb t = static_cast<DoubleLimb>(a) * b;
+                Limb m = static_cast<Limb>(t) * negativeInverse;
+                Limb u = static_cast<Limb>((t + static_cast<DoubleLimb>(m) * p) >> 64);
+                return u >= p ? u - p : u;
+            }
+
+            Limb add(Limb a, Limb b) const {
+                Limb sum = a + b;
+                return sum >= p ? sum - p : sum;
+            }
+
+            Limb subtract(Limb a, Limb b) const {
+                return a >= b ? a - b : a + p - b;
+            }
+
+            /**
+             * @brief Reduces any 64-bit value; every prime exceeds 2^64 / 5, so at most four
+             *        subtractions.
+             */
+            Limb reduce(Limb x) const {
+                while (x >= p) {
+                    x -= p;
+                }
+                return x;
+            }
+
+            Limb toMontgomery(Limb x) const {
+                return multiply(reduce(x), rSquared);
+            }
+
+            /**
+             * @brief Raises a Montgomery-form base to a plain exponent; the result stays in
+             *        Montgomery form.
+             */
+            Limb power(Limb base, Limb exponent) const {
+                Limb result = toMontgomery(1);
+                while (exponent != 0) {
+                    if (exponent & 1) {
+                        result = multiply(result, base);
+                    }
+                    base = multiply(base, base);
+                    exponent >>= 1;
+                }
+                return result;
+            }
+
+            /**
+             * @brief Powers of a primitive length-th root of unity (or its inverse), in
+             *        Montgomery form, for the first length / 2 exponents.
+             */
+            std::vector<Limb> twiddles(std::size_t length, bool inverse) const {
+                Limb root = power(toMontgomery(g), (p - 1) / length);
+                if (inverse) {
+                    root = power(root, length - 1);
+                }
+                std::vector<Limb> table(std::max<std::size_t>(length / 2, 1));
+                table[0] = toMontgomery(1);
+                for (std::size_t j = 1; j < table.size(); ++j) {
+                    table[j] = multiply(table[j - 1], root);
+                }
+                return table;
+            }
+
+        private:
+            Limb p;
+            Limb g;
+            Limb negativeInverse;
+            Limb rSquared;
+        };
+
+        // Primes c * 2^k + 1 just below 2^62 and a primitive root of each. Their product
+        // exceeds 2^185, enough for any convolution of up to 2^46 64-bit limbs.
+        const Limb NTT_PRIMES[3] = {4611615649683210241ULL, 4610208274799656961ULL, 4605071356474687489ULL};
+        const Limb NTT_GENERATORS[3] = {11, 3, 14};
+        const std::size_t NTT_MAX_LENGTH = std::size_t(1) << 46;
+
+        /**
+         * @brief Decimation-in-frequency transform: natural order in, bit-reversed out.
+         */
+        void forwardTransform(Limb *a, std::size_t length, const MontgomeryField &field,
+                              const std::vector<Limb> &roots) {
+            for (std::size_t half = length / 2; half >= 1; half /= 2) {
+                std::size_t stride = length / (2 * half);
+                for (std::size_t i = 0; i < length; i += 2 * half) {
+                    for (std::size_t j = 0; j < half; ++j) {
+                        Limb u = a[i + j];
+                        Limb v = a[i + j + half];
+                        a[i + j] = field.add(u, v);
+                        a[i + j + half] = field.multiply(field.subtract(u, v), roots[j * stride]);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Decimation-in-time inverse transform: bit-reversed in, natural order out,
+         *        without the final 1/length scaling.
+         */
+        void inverseTransform(Limb *a, std::size_t length, const MontgomeryField &field,
+                              const std::vector<Limb> &roots) {
+            for (std::size_t half = 1; half < length; half *= 2) {
+                std::size_t stride = length / (2 * half);
+                for (std::size_t i = 0; i < length; i += 2 * half) {
+                    for (std::size_t j = 0; j < half; ++j) {
+                        Limb u = a[i + j];
+                        Limb v = field.multiply(a[i + j + half], roots[j * stride]);
+                        a[i + j] = field.add(u, v);
+                        a[i + j + half] = field.subtract(u, v);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Cyclic convolution of a and b modulo one prime.
+         * @param out Receives length residues, each in [0, p).
+         */
+        void convolve(Limb *out, const Limb *a, std::size_t an, const Limb *b, std::size_t bn,
+                      std::size_t length, const MontgomeryField &field) {
+            // Squaring needs only one forward transform
+            bool squaring = a == b && an == bn;
+            BigIntArena::Scope scratch;
+            Limb *fb = squaring ? nullptr : scratch.allocate(length);
+            std::fill(out, out + length, 0);
+            if (!squaring) {
+                std::fill(fb, fb + length, 0);
+            }
+            for (std::size_t i = 0; i < an; ++i) {
+                out[i] = field.reduce(a[i]);
+            }
+            for (std::size_t i = 0; !squaring && i < bn; ++i) {
+                fb[i] = field.reduce(b[i]);
+            }
+
+            std::vector<Limb> roots = field.twiddles(length, false);
+            forwardTransform(out, length, field, roots);
+            if (!squaring) {
+                forwardTransform(fb, length, field, roots);
+            }
+            const Limb *transformB = squaring ? out : fb;
+
+            // The pointwise product picks up a factor R^-1 and the inverse transform a factor
+            // length; one multiplication by R^2 / length in Montgomery form undoes both.
+            Limb p = field.modulus();
+            Limb lengthInverse = p - (p - 1) / length;
+            Limb scale = field.toMontgomery(field.toMontgomery(lengthInverse));
+            for (std::size_t i = 0; i < length; ++i) {
+                out[i] = field.multiply(out[i], transformB[i]);
+            }
+
+            roots = field.twiddles(length, true);
+            inverseTransform(out, length, field, roots);
+            for (std::size_t i = 0; i < length; ++i) {
+                out[i] = field.multiply(out[i], scale);
+            }
+        }
+    }
+
+    /**
+     * @brief Product via three number-theoretic transforms and CRT reconstruction.
+     *
+     * Each limb is one coefficient; the convolution is computed modulo three 62-bit primes
+     * and every coefficient (below 2^186) is rebuilt with Garner's algorithm before the
+     * carries are propagated into r. Passing the same operand twice skips its second
+     * forward transform.
+     *
+     * @param r Output of an + bn limbs; must not overlap a or b.
+     * @throws std::length_error If the product exceeds the transform length the primes support.
+     */
+    void multiplyNtt(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+        std::size_t coefficients = an + bn - 1;
+        std::size_t length = 1;
+        while (length < coefficients) {
+            length *= 2;
+        }
+        if (length > NTT_MAX_LENGTH) {
+            throw std::length_error("BigInt operands too large for NTT multiplication");
+        }
+
+        MontgomeryField f0(NTT_PRIMES[0], NTT_GENERATORS[0]);
+        MontgomeryField f1(NTT_PRIMES[1], NTT_GENERATORS[1]);
+        MontgomeryField f2(NTT_PRIMES[2], NTT_GENERATORS[2]);
+
+        BigIntArena::Scope scratch;
+        Limb *r0 = scratch.allocate(3 * length);
+        Limb *r1 = r0 + length;
+        Limb *r2 = r1 + length;
+        // One convolution per prime; they run as tasks when the thread pool is enabled
+        BigIntThreadPool::TaskGroup tasks;
+        tasks.spawn([&] { convolve(r1, a, an, b, bn, length, f1); });
+        tasks.spawn([&] { convolve(r2, a, an, b, bn, length, f2); });
+        convolve(r0, a, an, b, bn, length, f0);
+        tasks.wait();
+
+        // Garner constants: p0^-1 mod p1 and (p0 p1)^-1 mod p2, in Montgomery form
+        Limb p0 = f0.modulus();
+        Limb p1 = f1.modulus();
+        Limb p2 = f2.modulus();
+        Limb p0Mont1 = f1.toMontgomery(p0);
+        Limb inverse01 = f1.power(p0Mont1, p1 - 2);
+        Limb p0Mont2 = f2.toMontgomery(p0);
+        Limb p01Mont2 = f2.multiply(p0Mont2, f2.toMontgomery(p1));
+        Limb inverse012 = f2.power(p01Mont2, p2 - 2);
+        DoubleLimb p01 = static_cast<DoubleLimb>(p0) * p1;
+        Limb p01Low = static_cast<Limb>(p01);
+        Limb p01High = static_cast<Limb>(p01 >> 64);
+
+        // Window of pending carries, two limbs wide
+        Limb carryLow = 0;
+        Limb carryHigh = 0;
+        for (std::size_t i = 0; i < coefficients; ++i) {
+            Limb x0 = r0[i];
+            // t1 = (x1 - x0) / p0 mod p1
+            Limb t1 = f1.multiply(f1.subtract(r1[i], f1.reduce(x0)), inverse01);
+            // t2 = (x2 - x0 - p0 t1) / (p0 p1) mod p2
+            Limb t2 = f2.subtract(r2[i], f2.reduce(x0));
+            t2 = f2.subtract(t2, f2.multiply(f2.reduce(t1), p0Mont2));
+            t2 = f2.multiply(t2, inverse012);
+
+            // value = x0 + p0 t1 + p0 p1 t2, as three limbs
+            DoubleLimb low = static_cast<DoubleLimb>(p0) * t1 + x0;
+            DoubleLimb x = static_cast<DoubleLimb>(p01Low) * t2 + static_cast<Limb>(low);
+            DoubleLimb y = static_cast<DoubleLimb>(p01High) * t2 + static_cast<Limb>(low >> 64) +
+                           static_cast<Limb>(x >> 64);
+            Limb v0 = static_cast<Limb>(x);
+            Limb v1 = static_cast<Limb>(y);
+            Limb v2 = static_cast<Limb>(y >> 64);
+
+            DoubleLimb s0 = static_cast<DoubleLimb>(v0) + carryLow;
+            r[i] = static_cast<Limb>(s0);
+            DoubleLimb s1 = static_cast<DoubleLimb>(v1) + carryHigh + static_cast<Limb>(s0 >> 64);
+            carryLow = static_cast<Limb>(s1);
+            carryHigh = v2 + static_cast<Limb>(s1 >> 64);
+        }
+        r[coefficients] = carryLow;
+    }
+}
@@ -0,0 +1,221 @@
+#include "BigIntKernels.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace bigint_kernels {
+    namespace {
+        // Largest power of ten that fits in a limb, and its number of decimal digits
+        const Limb DECIMAL_CHUNK = 10000000000000000000ULL;
+        const std::size_t DECIMAL_CHUNK_DIGITS = 19;
+        const Limb FIVE_CHUNK = 19073486328125ULL;  // 5^19
+
+        void trim(std::vector<Limb> &v) {
+            while (!v.empty() && v.back() == 0) {
+                v.pop_back();
+            }
+        }
+
+        /**
+         * @brief Returns 5^(19 * 2^k), the odd part of 10^(19 * 2^k), squaring up from
+         *        5^19 the first time each entry is asked for. Entries are never moved, so
+         *        references stay valid.
+         *
+         * The factor 2^(19 * 2^k) is applied as a shift, which keeps the multiplications
+         * and divisions below about 30% smaller.
+         */
+        const std::vector<Limb> &fivePower(std::size_t k) {
+            static std::deque<std::vector<Limb>> powers;
+            static std::mutex guard;
+
+            std::lock_guard<std::mutex> lock(guard);
+            if (powers.empty()) {
+                powers.push_back({FIVE_CHUNK});
+            }
+            while (powers.size() <= k) {
+                const std::vector<Limb> &last = powers.back();
+                std::vector<Limb> next(2 * last.size());
+                square(next.data(), last.data(), last.size());
+                trim(next);
+                powers.push_back(std::move(next));
+            }
+            return powers[k];
+        }
+
+        /**
+         * @brief Returns 10^(19 * 2^k), shifting up the matching fivePower() the first time
+         *        each entry is asked for. Entries are never moved, so references stay valid.
+         */
+        const std::vector<Limb> &decimalPower(std::size_t k) {
+            static std::deque<std::vector<Limb>> powers;
+            static std::mutex guard;
+
+            std::lock_guard<std::mutex> lock(guard);
+            while (powers.size() <= k) {
+                std::size_t exponent = DECIMAL_CHUNK_DIGITS << powers.size();
+                const std::vector<Limb> &five = fivePower(powers.size());
+                std::vector<Limb> power(exponent / 64 + five.size() + 1);
+                power.back() = shiftLeft(power.data() + exponent / 64, five.data(), five.size(),
+                                         static_cast<unsigned>(exponent % 64));
+                trim(power);
+                powers.push_back(std::move(power));
+            }
+            return powers[k];
+        }
+
+        /**
+         * @brief Quadratic conversion of a short digit string, 19 digits per step.
+         */
+        std::vector<Limb> parseBasecase(const char *digits, std::size_t n) {
+            std::vector<Limb> result;
+            result.reserve(n / DECIMAL_CHUNK_DIGITS + 1);
+
+            // The leading chunk carries the remainder so every later chunk is full
+            std::size_t chunkLength = n % DECIMAL_CHUNK_DIGITS;
+            if (chunkLength == 0) {
+                chunkLength = DECIMAL_CHUNK_DIGITS;
+            }
+            for (std::size_t pos = 0; pos < n; pos += chunkLength, chunkLength = DECIMAL_CHUNK_DIGITS) {
+                Limb chunk = 0;
+                Limb scale = 1;
+                for (std::size_t i = pos; i < pos + chunkLength; ++i) {
+                    chunk = chunk * 10 + static_cast<Limb>(digits[i] - '0');
+                    scale *= 10;
+                }
+                Limb carry = multiply1(result.data(), result.data(), result.size(), scale);
+                if (carry != 0) {
+                    result.push_back(carry);
+                }
+                if (chunk != 0) {
+                    if (result.empty()) {
+                        result.push_back(chunk);
+                    } else if (add(result.data(), result.data(), result.size(), &chunk, 1) != 0) {
+                        result.push_back(1);
+                    }
+                }
+            }
+            trim(result);
+            return result;
+        }
+
+        /**
+         * @brief Splits the digits at 19 * 2^k from the right, converts both halves
+         *        recursively and recombines them as high * 10^(19 * 2^k) + low.
+         */
+        std::vector<Limb> parse(const char *digits, std::size_t n) {
+            if (n < RADIX_THRESHOLD * DECIMAL_CHUNK_DIGITS) {
+                return parseBasecase(digits, n);
+            }
+
+            // Largest power whose digit count stays below n, so the low half is >= n / 2
+            std::size_t k = 0;
+            while (2 * (DECIMAL_CHUNK_DIGITS << k) < n) {
+                ++k;
+            }
+            std::size_t lowDigits = DECIMAL_CHUNK_DIGITS << k;
+            std::vector<Limb> high = parse(digits, n - lowDigits);
+            std::vector<Limb> low = parse(digits + n - lowDigits, lowDigits);
+            if (high.empty()) {
+                return low;
+            }
+
+            // high * 10^e = (high * 5^e) << e
+            const std::vector<Limb> &five = fivePower(k);
+            std::size_t limbShift = lowDigits / 64;
+            std::size_t productSize = high.size() + five.size();
+            std::vector<Limb> result(limbShift + productSize + 1);
+            multiply(result.data() + limbShift, high.data(), high.size(), five.data(), five.size());
+            result.back() = shiftLeft(result.data() + limbShift, result.data() + limbShift, productSize,
+                                      static_cast<unsigned>(lowDigits % 64));
+            if (!low.empty()) {
+                add(result.data(), result.data(), result.size(), low.data(), low.size());
+            }
+            trim(result);
+            return result;
+        }
+
+        /**
+         * @brief Quadratic conversion of a short value into exactly width digits, peeling
+         *        off 19 digits per single-limb division.
+         */
+        void printBasecase(char *out, std::size_t width, const Limb *a, std::size_t n) {
+            std::vector<Limb> rest(a, a + n);
+            std::size_t pos = width;
+            while (!rest.empty()) {
+                Limb chunk = divide1(rest.data(), rest.data(), rest.size(), DECIMAL_CHUNK);
+                trim(rest);
+                for (std::size_t i = 0; i < DECIMAL_CHUNK_DIGITS && pos > 0; ++i) {
+                    out[--pos] = static_cast<char>('0' + chunk % 10);
+                    chunk /= 10;
+                }
+            }
+            std::fill(out, out + pos, '0');
+        }
+
+        /**
+         * @brief Divides by the cached power of ten closest to the square root of the
+         *        value and prints the quotient and the zero-padded remainder recursively.
+         */
+        void print(char *out, std::size_t width, const Limb *a, std::size_t n) {
+            while (n > 0 && a[n - 1] == 0) {
+                --n;
+            }
+            if (n < RADIX_THRESHOLD) {
+                printBasecase(out, width, a, n);
+                return;
+            }
+
+            // Largest power of at most about half the limbs of the value
+            std::size_t k = 0;
+            while (2 * decimalPower(k + 1).size() <= n + 1) {
+                ++k;
+            }
+            const std::vector<Limb> &power = decimalPower(k);
+            std::size_t lowDigits = DECIMAL_CHUNK_DIGITS << k;
+
+            std::vector<Limb> quotient(n - power.size() + 1);
+            std::vector<Limb> remainder(power.size());
+            divide(quotient.data(), remainder.data(), a, n, power.data(), power.size());
+            print(out, width - lowDigits, quotient.data(), quotient.size());
+            print(out + width - lowDigits, lowDigits, remainder.data(), remainder.size());
+        }
+    }
+
+    /**
+     * @brief Upper bound on the number of decimal digits of an n-limb value.
+     */
+    std::size_t decimalDigitsBound(std::size_t n) {
+        // 1234 / 4096 is just above log10(2)
+        return n * 64 * 1234 / 4096 + 1;
+    }
+
+    /**
+     * @brief Converts a string of n decimal digits (no sign) into limbs.
+     *
+     * Long inputs are split in half recursively and recombined with the cached powers
+     * 10^(19 * 2^k) = 5^(19 * 2^k) 2^(19 * 2^k), so the cost is a few multiplications of the final size.
+     *
+     * @param r Output of n / 19 + 1 limbs.
+     * @return The number of significant limbs written.
+     */
+    std::size_t fromDecimal(Limb *r, const char *digits, std::size_t n) {
+        std::vector<Limb> result = parse(digits, n);
+        std::fill(std::copy(result.begin(), result.end(), r), r + n / DECIMAL_CHUNK_DIGITS + 1, Limb(0));
+        return result.size();
+    }
+
+    /**
+     * @brief Writes an n-limb value as exactly width decimal digits, padded with leading
+     *        zeros.
+     *
+     * Long values are divided by the cached power of ten nearest their square root and
+     * both halves printed recursively, so the cost is a few divisions of the full size.
+     *
+     * @param out Output of width characters; width must be at least the digit count,
+     *        e.g. decimalDigitsBound(n).
+     */
+    void toDecimal(char *out, std::size_t width, const Limb *a, std::size_t n) {
+        print(out, width, a, n);
+    }
+}
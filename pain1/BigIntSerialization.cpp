@@ -0,0 +1,510 @@
+#include "BigIntSerialization.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include "BigIntKernels.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BIGINT_HAVE_MMAP 1
+#endif
+
+namespace {
+    using Limb = BigInt::Limb;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    const bool HOST_IS_BIG_ENDIAN = true;
+#else
+    const bool HOST_IS_BIG_ENDIAN = false;
+#endif
+
+    // Limbs read from a stream per step, so a corrupt count fails on the data
+    // instead of allocating it all up front
+    const std::size_t READ_CHUNK = std::size_t(1) << 20;
+
+    struct Header {
+        bool negative;
+        std::uint64_t count;
+    };
+
+    std::uint64_t loadLittleEndian(const unsigned char *bytes, std::size_t width) {
+        std::uint64_t value = 0;
+        for (std::size_t i = width; i-- > 0;) {
+            value = value << 8 | bytes[i];
+        }
+        return value;
+    }
+
+    void storeLittleEndian(unsigned char *bytes, std::uint64_t value, std::size_t width) {
+        for (std::size_t i = 0; i < width; ++i) {
+            bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    /**
+     * @brief Converts limbs between host order and the little-endian file order.
+     */
+    void swapLimbs(Limb *limbs, std::size_t n) {
+        if (HOST_IS_BIG_ENDIAN) {
+            for (std::size_t i = 0; i < n; ++i) {
+                limbs[i] = __builtin_bswap64(limbs[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Decodes and checks a header; the caller checks the limbs it announces.
+     * @throws std::invalid_argument If the magic, version or flags are wrong.
+     */
+    Header parseHeader(const unsigned char *bytes) {
+        if (std::memcmp(bytes, bigint_format::MAGIC, sizeof(bigint_format::MAGIC)) != 0) {
+            throw std::invalid_argument("Not a serialized BigInt");
+        }
+        if (loadLittleEndian(bytes + 4, 2) != bigint_format::VERSION) {
+            throw std::invalid_argument("Unsupported BigInt format version");
+        }
+        std::uint64_t flags = loadLittleEndian(bytes + 6, 2);
+        if ((flags & ~std::uint64_t(bigint_format::NEGATIVE)) != 0) {
+            throw std::invalid_argument("Unknown flags in serialized BigInt");
+        }
+        Header header{flags != 0, loadLittleEndian(bytes + 8, 8)};
+        if (header.negative && header.count == 0) {
+            throw std::invalid_argument("Serialized BigInt has a negative zero");
+        }
+        return header;
+    }
+
+    /**
+     * @brief Decodes the header of a record in a buffer of the given size.
+     * @throws std::invalid_argument If the header is invalid or the limbs do not fit.
+     */
+    Header parseRecord(const unsigned char *bytes, std::size_t size) {
+        if (size < bigint_format::HEADER_SIZE) {
+            throw std::invalid_argument("Serialized BigInt is truncated");
+        }
+        Header header = parseHeader(bytes);
+        if (header.count > (size - bigint_format::HEADER_SIZE) / sizeof(Limb)) {
+            throw std::invalid_argument("Serialized BigInt is truncated");
+        }
+        return header;
+    }
+
+    void checkTopLimb(Limb top) {
+        if (top == 0) {
+            throw std::invalid_argument("Serialized BigInt has a leading zero limb");
+        }
+    }
+
+    void writeHeader(unsigned char *out, const BigIntView &value) {
+        std::memcpy(out, bigint_format::MAGIC, sizeof(bigint_format::MAGIC));
+        storeLittleEndian(out + 4, bigint_format::VERSION, 2);
+        storeLittleEndian(out + 6, value.isNegative() ? bigint_format::NEGATIVE : 0, 2);
+        storeLittleEndian(out + 8, value.size(), 8);
+    }
+}
+
+/**
+ * @brief Moves limbs between BigInt and its views and serialised records.
+ */
+class BigIntSerialization {
+public:
+    static BigIntView view(const BigInt &value) {
+        return BigIntView(value.limbs.data(), value.limbs.size(), value.isNegative);
+    }
+
+    /**
+     * @brief A BigInt from a copy of n limbs, which may be unaligned.
+     * @param fileOrder Whether the limbs are little-endian rather than in host order.
+     */
+    static BigInt fromLimbs(const void *limbs, std::size_t n, bool negative, bool fileOrder) {
+        BigInt result;
+        result.limbs.resize(n);
+        std::memcpy(result.limbs.data(), limbs, n * sizeof(Limb));
+        if (fileOrder) {
+            swapLimbs(result.limbs.data(), n);
+        }
+        result.isNegative = negative;
+        return result;
+    }
+
+    /**
+     * @brief Reads the limbs of a record from a stream positioned after its header.
+     */
+    static BigInt fromStream(std::istream &in, const Header &header) {
+        BigInt result;
+        std::size_t done = 0;
+        while (done < header.count) {
+            std::size_t step = static_cast<std::size_t>(std::min<std::uint64_t>(header.count - done, READ_CHUNK));
+            result.limbs.resize(done + step);
+            in.read(reinterpret_cast<char *>(result.limbs.data() + done),
+                    static_cast<std::streamsize>(step * sizeof(Limb)));
+            if (!in) {
+                throw std::invalid_argument("Serialized BigInt is truncated");
+            }
+            swapLimbs(result.limbs.data() + done, step);
+            done += step;
+        }
+        if (!result.limbs.empty()) {
+            checkTopLimb(result.limbs.back());
+        }
+        result.isNegative = header.negative;
+        return result;
+    }
+};
+
+//========== Constructors ==========
+
+/**
+ * @brief Views the limbs of a BigInt.
+ * @param value The value; must outlive the view and stay unmodified.
+ */
+BigIntView::BigIntView(const BigInt &value) : BigIntView(BigIntSerialization::view(value)) {}
+
+/**
+ * @brief Views a serialised record in place.
+ * @param bytes The record; must be 8-byte aligned.
+ * @param size Number of readable bytes; may extend past the record.
+ * @throws std::invalid_argument If the record is malformed, truncated or misaligned.
+ */
+BigIntView::BigIntView(const unsigned char *bytes, std::size_t size) {
+    Header header = parseRecord(bytes, size);
+    if (reinterpret_cast<std::uintptr_t>(bytes) % alignof(Limb) != 0) {
+        throw std::invalid_argument("Serialized BigInt is not 8-byte aligned");
+    }
+    if (HOST_IS_BIG_ENDIAN && header.count > 0) {
+        throw std::invalid_argument("Serialized BigInt cannot be viewed on a big-endian host");
+    }
+    data = reinterpret_cast<const Limb *>(bytes + bigint_format::HEADER_SIZE);
+    length = static_cast<std::size_t>(header.count);
+    negative = header.negative;
+    if (length > 0) {
+        checkTopLimb(data[length - 1]);
+    }
+}
+
+BigIntView::BigIntView(const Limb *data, std::size_t length, bool negative)
+    : data(data), length(length), negative(negative) {}
+
+//========== Accessors ==========
+
+/**
+ * @brief Number of bits in the magnitude, ignoring the sign.
+ * @return The bit length, which is 0 for zero.
+ */
+std::size_t BigIntView::bitLength() const {
+    if (length == 0) {
+        return 0;
+    }
+    return 64 * length - static_cast<std::size_t>(__builtin_clzll(data[length - 1]));
+}
+
+/**
+ * @brief Reads one bit of the magnitude.
+ * @param index The bit position, counted from the least significant bit.
+ * @return True if the bit is set.
+ */
+bool BigIntView::testBit(std::size_t index) const {
+    return index / 64 < length && (data[index / 64] >> (index % 64) & 1) != 0;
+}
+
+//========== Conversions ==========
+
+/**
+ * @brief Copies the viewed value into a BigInt.
+ * @return The value.
+ */
+BigInt BigIntView::toBigInt() const {
+    return BigIntSerialization::fromLimbs(data, length, negative, false);
+}
+
+/**
+ * @brief Decimal representation, converted straight from the viewed limbs.
+ * @return The digits, with a leading '-' for negative values.
+ */
+std::string BigIntView::toString() const {
+    if (length == 0) {
+        return "0";
+    }
+    std::string digits(bigint_kernels::decimalDigitsBound(length), '0');
+    bigint_kernels::toDecimal(&digits[0], digits.size(), data, length);
+    return (negative ? "-" : "") + digits.substr(digits.find_first_not_of('0'));
+}
+
+//========== Comparison Operators ==========
+
+/**
+ * @brief Three-way comparison of two viewed values.
+ * @return Negative, zero or positive as a is less than, equal to or greater than b.
+ */
+int compare(const BigIntView &a, const BigIntView &b) {
+    if (a.negative != b.negative) {
+        return a.negative ? -1 : 1;
+    }
+    int magnitude = bigint_kernels::compare(a.data, a.length, b.data, b.length);
+    return a.negative ? -magnitude : magnitude;
+}
+
+//========== Input/Output Stream Overloads ==========
+
+std::ostream &operator<<(std::ostream &out, const BigIntView &view) {
+    out << view.toString();
+    return out;
+}
+
+//========== Memory Mapping ==========
+
+/**
+ * @brief Maps a file.
+ * @param path The file.
+ * @throws std::runtime_error If the file cannot be opened or mapped.
+ */
+BigIntMapping::BigIntMapping(const std::string &path) : bytes(nullptr), length(0) {
+#ifdef BIGINT_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    if (length > 0) {
+        void *mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map " + path);
+        }
+        bytes = static_cast<const unsigned char *>(mapped);
+    }
+    ::close(fd);  // The mapping keeps the file open
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    length = static_cast<std::size_t>(in.tellg());
+    copy.resize((length + sizeof(BigInt::Limb) - 1) / sizeof(BigInt::Limb));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char *>(copy.data()), static_cast<std::streamsize>(length))) {
+        throw std::runtime_error("Cannot read " + path);
+    }
+    bytes = reinterpret_cast<const unsigned char *>(copy.data());
+#endif
+}
+
+BigIntMapping::BigIntMapping(BigIntMapping &&other) noexcept
+    : bytes(other.bytes), length(other.length), copy(std::move(other.copy)) {
+    other.bytes = nullptr;
+    other.length = 0;
+}
+
+/**
+ * @brief Unmaps the file; views into it become invalid.
+ */
+BigIntMapping::~BigIntMapping() {
+    unmap();
+}
+
+BigIntMapping &BigIntMapping::operator=(BigIntMapping &&other) noexcept {
+    if (this != &other) {
+        unmap();
+        bytes = other.bytes;
+        length = other.length;
+        copy = std::move(other.copy);
+        other.bytes = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief Views the record at a byte offset of the file.
+ * @param offset The record's offset, a multiple of 8.
+ * @return The view, valid while the mapping is.
+ * @throws std::invalid_argument If there is no valid record at the offset.
+ */
+BigIntView BigIntMapping::view(std::size_t offset) const {
+    if (offset > length) {
+        throw std::invalid_argument("Serialized BigInt is truncated");
+    }
+    return BigIntView(bytes + offset, length - offset);
+}
+
+void BigIntMapping::unmap() {
+#ifdef BIGINT_HAVE_MMAP
+    if (bytes != nullptr) {
+        ::munmap(const_cast<unsigned char *>(bytes), length);
+    }
+#endif
+    bytes = nullptr;
+    length = 0;
+    copy.clear();
+}
+
+//========== Serialization ==========
+
+/**
+ * @brief Size of a value's serialised record.
+ * @param value The value.
+ * @return Header plus limbs, in bytes.
+ */
+std::size_t serializedSize(const BigIntView &value) {
+    return bigint_format::HEADER_SIZE + value.size() * sizeof(Limb);
+}
+
+/**
+ * @brief Writes a value's record into a buffer.
+ * @param value The value.
+ * @param out At least serializedSize(value) bytes.
+ */
+void serialize(const BigIntView &value, unsigned char *out) {
+    writeHeader(out, value);
+    unsigned char *limbs = out + bigint_format::HEADER_SIZE;
+    if (!HOST_IS_BIG_ENDIAN) {
+        std::memcpy(limbs, value.limbs(), value.size() * sizeof(Limb));
+        return;
+    }
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        storeLittleEndian(limbs + i * sizeof(Limb), value.limbs()[i], sizeof(Limb));
+    }
+}
+
+/**
+ * @brief Serialises a value into a new buffer.
+ * @param value The value.
+ * @return Its record.
+ */
+std::vector<unsigned char> serialize(const BigIntView &value) {
+    std::vector<unsigned char> out(serializedSize(value));
+    serialize(value, out.data());
+    return out;
+}
+
+/**
+ * @brief Appends a value's record to a binary stream; on little-endian hosts the limbs
+ *        are written straight from the value.
+ * @param value The value.
+ * @param out The stream; should be opened in binary mode.
+ * @throws std::runtime_error If the stream fails.
+ */
+void serialize(const BigIntView &value, std::ostream &out) {
+    unsigned char header[bigint_format::HEADER_SIZE];
+    writeHeader(header, value);
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    if (!HOST_IS_BIG_ENDIAN) {
+        out.write(reinterpret_cast<const char *>(value.limbs()),
+                  static_cast<std::streamsize>(value.size() * sizeof(Limb)));
+    } else {
+        std::vector<Limb> chunk;
+        for (std::size_t done = 0; done < value.size(); done += chunk.size()) {
+            chunk.assign(value.limbs() + done, value.limbs() + std::min(value.size(), done + READ_CHUNK));
+            swapLimbs(chunk.data(), chunk.size());
+            out.write(reinterpret_cast<const char *>(chunk.data()),
+                      static_cast<std::streamsize>(chunk.size() * sizeof(Limb)));
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write serialized BigInt");
+    }
+}
+
+/**
+ * @brief Writes a value's record to a file, replacing it.
+ *
+ * The record goes to a temporary file next to the target, which is renamed over it
+ * once complete, so a crash never leaves a partly written checkpoint behind.
+ *
+ * @param value The value.
+ * @param path The file.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void serialize(const BigIntView &value, const std::string &path) {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot open " + temporary);
+        }
+        try {
+            serialize(value, out);
+            out.close();
+            if (!out) {
+                throw std::runtime_error("Failed to write serialized BigInt");
+            }
+        } catch (...) {
+            out.close();
+            std::remove(temporary.c_str());
+            throw;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Cannot replace " + path);
+    }
+}
+
+//========== Deserialization ==========
+
+/**
+ * @brief Reads the record at the start of a buffer; bytes after it are ignored.
+ * @param bytes The buffer; need not be aligned.
+ * @param size Its size in bytes.
+ * @return The value.
+ * @throws std::invalid_argument If the record is malformed or truncated.
+ */
+BigInt deserialize(const unsigned char *bytes, std::size_t size) {
+    Header header = parseRecord(bytes, size);
+    std::size_t count = static_cast<std::size_t>(header.count);
+    BigInt result = BigIntSerialization::fromLimbs(bytes + bigint_format::HEADER_SIZE, count, header.negative, true);
+    if (count > 0) {
+        checkTopLimb(loadLittleEndian(bytes + bigint_format::HEADER_SIZE + (count - 1) * sizeof(Limb), 8));
+    }
+    return result;
+}
+
+/**
+ * @brief Reads the record at the start of a buffer.
+ * @param bytes The buffer.
+ * @return The value.
+ * @throws std::invalid_argument If the record is malformed or truncated.
+ */
+BigInt deserialize(const std::vector<unsigned char> &bytes) {
+    return deserialize(bytes.data(), bytes.size());
+}
+
+/**
+ * @brief Reads the next record from a binary stream.
+ * @param in The stream; left just past the record.
+ * @return The value.
+ * @throws std::invalid_argument If the record is malformed or truncated.
+ */
+BigInt deserialize(std::istream &in) {
+    unsigned char header[bigint_format::HEADER_SIZE];
+    if (!in.read(reinterpret_cast<char *>(header), sizeof(header))) {
+        throw std::invalid_argument("Serialized BigInt is truncated");
+    }
+    return BigIntSerialization::fromStream(in, parseHeader(header));
+}
+
+/**
+ * @brief Reads the first record of a file.
+ * @param path The file.
+ * @return The value.
+ * @throws std::runtime_error If the file cannot be opened.
+ * @throws std::invalid_argument If the record is malformed or truncated.
+ */
+BigInt deserialize(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    return deserialize(in);
+}
@@ -0,0 +1,231 @@
+#ifndef BIGINT_SERIALIZATION_H
+#define BIGINT_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BigInt.h"
+
+/**
+ * @brief Binary format of a serialised BigInt, version 1.
+ *
+ * A 16-byte header followed by the magnitude as raw limbs, least significant first.
+ * Every field is little-endian:
+ *
+ *     offset 0   4 bytes  magic "BIGN"
+ *     offset 4   uint16   format version
+ *     offset 6   uint16   flags; bit 0 is the sign
+ *     offset 8   uint64   limb count n
+ *     offset 16  n uint64 limbs; the last one is never zero
+ *
+ * The limbs start 8 bytes into an 8-aligned record, so a record at an 8-aligned offset
+ * of a memory-mapped file can be read in place by a BigIntView.
+ */
+namespace bigint_format {
+    const char MAGIC[4] = {'B', 'I', 'G', 'N'};
+
+    const std::uint16_t VERSION = 1;
+
+    const std::uint16_t NEGATIVE = 1;
+
+    const std::size_t HEADER_SIZE = 16;
+}
+
+/**
+ * @brief A read-only view of a BigInt's limbs, held elsewhere.
+ *
+ * A view either refers to a live BigInt or to a serialised record, typically in a
+ * memory-mapped file, and reads it without copying. It stays valid as long as the
+ * memory it refers to, and the BigInt is not modified.
+ */
+class BigIntView {
+public:
+    using Limb = BigInt::Limb;
+
+    //=================== Constructors ===================
+    /**
+     * @brief Views the limbs of a BigInt.
+     * @param value The value; must outlive the view and stay unmodified.
+     */
+    BigIntView(const BigInt &value);
+
+    /**
+     * @brief Views a serialised record in place.
+     * @param bytes The record; must be 8-byte aligned.
+     * @param size Number of readable bytes; may extend past the record.
+     * @throws std::invalid_argument If the record is malformed, truncated or misaligned.
+     */
+    BigIntView(const unsigned char *bytes, std::size_t size);
+
+    //=================== Accessors ===================
+    const Limb *limbs() const { return data; }
+
+    std::size_t size() const { return length; }
+
+    bool isNegative() const { return negative; }
+
+    bool isZero() const { return length == 0; }
+
+    std::size_t bitLength() const;
+
+    bool testBit(std::size_t index) const;
+
+    //=================== Conversions ===================
+    BigInt toBigInt() const;
+
+    std::string toString() const;
+
+    //=================== Comparison Operators ===================
+    friend int compare(const BigIntView &a, const BigIntView &b);
+
+    friend bool operator==(const BigIntView &a, const BigIntView &b) { return compare(a, b) == 0; }
+
+    friend bool operator!=(const BigIntView &a, const BigIntView &b) { return compare(a, b) != 0; }
+
+    friend bool operator<(const BigIntView &a, const BigIntView &b) { return compare(a, b) < 0; }
+
+    friend bool operator<=(const BigIntView &a, const BigIntView &b) { return compare(a, b) <= 0; }
+
+    friend bool operator>(const BigIntView &a, const BigIntView &b) { return compare(a, b) > 0; }
+
+    friend bool operator>=(const BigIntView &a, const BigIntView &b) { return compare(a, b) >= 0; }
+
+    //=================== I/O Stream Overloads ===================
+    friend std::ostream &operator<<(std::ostream &out, const BigIntView &view);
+
+private:
+    friend class BigIntSerialization;
+
+    const Limb *data;
+    std::size_t length;
+    bool negative;
+
+    BigIntView(const Limb *data, std::size_t length, bool negative);
+};
+
+/**
+ * @brief A serialised file mapped read-only into memory, for BigIntView access without
+ *        reading it.
+ *
+ * Pages are loaded by the operating system as the views touch them. Where mmap is not
+ * available the file is read into memory instead.
+ */
+class BigIntMapping {
+public:
+    //=================== Constructors ===================
+    /**
+     * @brief Maps a file.
+     * @param path The file.
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit BigIntMapping(const std::string &path);
+
+    BigIntMapping(BigIntMapping &&other) noexcept;
+
+    BigIntMapping(const BigIntMapping &) = delete;
+
+    //=================== Destructor ===================
+    ~BigIntMapping();
+
+    //=================== Assignment Operators ===================
+    BigIntMapping &operator=(BigIntMapping &&other) noexcept;
+
+    BigIntMapping &operator=(const BigIntMapping &) = delete;
+
+    //=================== Accessors ===================
+    const unsigned char *data() const { return bytes; }
+
+    std::size_t size() const { return length; }
+
+    /**
+     * @brief Views the record at a byte offset of the file.
+     * @param offset The record's offset, a multiple of 8; records follow each other at
+     *        offsets advanced by serializedSize().
+     * @return The view, valid while the mapping is.
+     * @throws std::invalid_argument If there is no valid record at the offset.
+     */
+    BigIntView view(std::size_t offset = 0) const;
+
+private:
+    const unsigned char *bytes;
+    std::size_t length;
+    // Holds the file where it could not be mapped; empty otherwise
+    std::vector<BigInt::Limb> copy;
+
+    void unmap();
+};
+
+/**
+ * @brief Size of a value's serialised record.
+ * @param value The value.
+ * @return Header plus limbs, in bytes.
+ */
+std::size_t serializedSize(const BigIntView &value);
+
+/**
+ * @brief Writes a value's record into a buffer.
+ * @param value The value.
+ * @param out At least serializedSize(value) bytes.
+ */
+void serialize(const BigIntView &value, unsigned char *out);
+
+/**
+ * @brief Serialises a value into a new buffer.
+ * @param value The value.
+ * @return Its record.
+ */
+std::vector<unsigned char> serialize(const BigIntView &value);
+
+/**
+ * @brief Appends a value's record to a binary stream.
+ * @param value The value.
+ * @param out The stream; should be opened in binary mode.
+ * @throws std::runtime_error If the stream fails.
+ */
+void serialize(const BigIntView &value, std::ostream &out);
+
+/**
+ * @brief Writes a value's record to a file, replacing it.
+ * @param value The value.
+ * @param path The file.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void serialize(const BigIntView &value, const std::string &path);
+
+/**
+ * @brief Reads the record at the start of a buffer; bytes after it are ignored.
+ * @param bytes The buffer; need not be aligned.
+ * @param size Its size in bytes.
+ * @return The value.
+ * @throws std::invalid_argument If the record is malformed or truncated.
+ */
+BigInt deserialize(const unsigned char *bytes, std::size_t size);
+
+/**
+ * @brief Reads the record at the start of a buffer.
+ * @param bytes The buffer.
+ * @return The value.
+ * @throws std::invalid_argument If the record is malformed or truncated.
+ */
+BigInt deserialize(const std::vector<unsigned char> &bytes);
+
+/**
+ * @brief Reads the next record from a binary stream.
+ * @param in The stream; left just past the record.
+ * @return The value.
+ * @throws std::invalid_argument If the record is malformed or truncated.
+ */
+BigInt deserialize(std::istream &in);
+
+/**
+ * @brief Reads the first record of a file.
+ * @param path The file.
+ * @return The value.
+ * @throws std::runtime_error If the file cannot be opened.
+ * @throws std::invalid_argument If the record is malformed or truncated.
+ */
+BigInt deserialize(const std::string &path);
+
+#endif // BIGINT_SERIALIZATION_H
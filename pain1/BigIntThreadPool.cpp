@@ -0,0 +1,252 @@
+#include "BigIntThreadPool.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    // The shared pool; kernels read it on every large multiplication
+    std::atomic<BigIntThreadPool *> shared(nullptr);
+
+    // Owns the shared pool and serialises start() and stop()
+    std::mutex sharedLock;
+    std::unique_ptr<BigIntThreadPool> sharedOwner;
+
+    // The pool and deque index of the current thread, if it is a worker
+    thread_local const BigIntThreadPool *workerPool = nullptr;
+    thread_local std::size_t workerIndex = 0;
+}
+
+//========== Task Groups ==========
+
+/**
+ * @brief Creates an empty group bound to the shared pool, if it is running.
+ */
+BigIntThreadPool::TaskGroup::TaskGroup() : pool(shared.load(std::memory_order_acquire)), pending(0) {}
+
+/**
+ * @brief Waits for any tasks still pending; their exceptions are dropped.
+ */
+BigIntThreadPool::TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+        // A destructor must not throw; wait() was skipped because of an earlier error
+    }
+}
+
+/**
+ * @brief Queues a task, or runs it right away when the pool is stopped.
+ * @param task The work; it must stay valid until wait() returns.
+ */
+void BigIntThreadPool::TaskGroup::spawn(std::function<void()> task) {
+    if (pool == nullptr) {
+        task();
+        return;
+    }
+    pending.fetch_add(1, std::memory_order_relaxed);
+    pool->push(Task{std::move(task), this});
+}
+
+/**
+ * @brief Runs queued tasks until every task of the group has finished.
+ * @throws The first exception thrown by one of the group's tasks.
+ */
+void BigIntThreadPool::TaskGroup::wait() {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        Task task;
+        if (pool->findTask(task)) {
+            execute(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    std::exception_ptr failure;
+    {
+        std::lock_guard<std::mutex> guard(errorLock);
+        std::swap(failure, error);
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+//========== Shared Pool ==========
+
+/**
+ * @brief Starts the shared pool, replacing a running one.
+ * @param threads Number of worker threads; 0 uses one per hardware thread.
+ */
+void BigIntThreadPool::start(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::lock_guard<std::mutex> guard(sharedLock);
+    shared.store(nullptr, std::memory_order_release);
+    sharedOwner.reset(new BigIntThreadPool(threads));
+    shared.store(sharedOwner.get(), std::memory_order_release);
+}
+
+/**
+ * @brief Stops the shared pool; must not be called while a multiplication is running.
+ */
+void BigIntThreadPool::stop() {
+    std::lock_guard<std::mutex> guard(sharedLock);
+    shared.store(nullptr, std::memory_order_release);
+    sharedOwner.reset();
+}
+
+/**
+ * @brief Checks whether parallel multiplication is enabled.
+ * @return True while the shared pool is running.
+ */
+bool BigIntThreadPool::running() {
+    return shared.load(std::memory_order_relaxed) != nullptr;
+}
+
+/**
+ * @brief Number of worker threads of the shared pool.
+ * @return The worker count, or 0 when the pool is stopped.
+ */
+unsigned BigIntThreadPool::size() {
+    BigIntThreadPool *pool = shared.load(std::memory_order_acquire);
+    return pool == nullptr ? 0 : static_cast<unsigned>(pool->workers.size());
+}
+
+//========== Constructors and Destructor ==========
+
+/**
+ * @brief Starts the worker threads.
+ * @param threads Number of workers, at least one.
+ */
+BigIntThreadPool::BigIntThreadPool(unsigned threads) : queued(0), stopping(false) {
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(new Worker());
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        this->threads.emplace_back(&BigIntThreadPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Wakes and joins every worker.
+ */
+BigIntThreadPool::~BigIntThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping.store(true);
+    }
+    wakeup.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+//========== Scheduling ==========
+
+/**
+ * @brief Queues a task on the current worker's deque, or on the shared queue when
+ *        called from outside the pool, and wakes a sleeping worker.
+ * @param task The task to queue.
+ */
+void BigIntThreadPool::push(Task task) {
+    // Counted first, so a worker that sees an empty count can safely go to sleep
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        queued.fetch_add(1);
+    }
+    int self = currentWorker();
+    if (self >= 0) {
+        Worker &worker = *workers[static_cast<std::size_t>(self)];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        worker.tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> guard(injectedLock);
+        injected.push_back(std::move(task));
+    }
+    wakeup.notify_one();
+}
+
+/**
+ * @brief Takes a task: the newest one of the current worker, else the oldest one of
+ *        another worker, else the oldest one spawned from outside the pool.
+ * @param task Receives the task.
+ * @return True if a task was found.
+ */
+bool BigIntThreadPool::findTask(Task &task) {
+    if (queued.load() == 0) {
+        return false;
+    }
+    int self = currentWorker();
+    std::size_t count = workers.size();
+    if (self >= 0) {
+        Worker &worker = *workers[static_cast<std::size_t>(self)];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        if (!worker.tasks.empty()) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    std::size_t first = self >= 0 ? static_cast<std::size_t>(self) + 1 : 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Worker &victim = *workers[(first + i) % count];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    std::lock_guard<std::mutex> guard(injectedLock);
+    if (!injected.empty()) {
+        task = std::move(injected.front());
+        injected.pop_front();
+        queued.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Runs a task, records its exception in the group and marks it finished.
+ * @param task The task to run.
+ */
+void BigIntThreadPool::execute(Task &task) {
+    TaskGroup *group = task.group;
+    try {
+        task.run();
+    } catch (...) {
+        std::lock_guard<std::mutex> guard(group->errorLock);
+        if (!group->error) {
+            group->error = std::current_exception();
+        }
+    }
+    group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * @brief Main loop of worker `index`: run tasks while there are any, otherwise sleep.
+ * @param index The worker's deque.
+ */
+void BigIntThreadPool::workerLoop(std::size_t index) {
+    workerPool = this;
+    workerIndex = index;
+    while (!stopping.load()) {
+        Task task;
+        if (findTask(task)) {
+            execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wakeup.wait(guard, [this] { return stopping.load() || queued.load() > 0; });
+    }
+}
+
+/**
+ * @brief The current thread's deque in this pool.
+ * @return Its index, or -1 if the thread is not one of this pool's workers.
+ */
+int BigIntThreadPool::currentWorker() const {
+    return workerPool == this ? static_cast<int>(workerIndex) : -1;
+}
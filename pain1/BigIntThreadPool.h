@@ -0,0 +1,127 @@
+#ifndef BIGINT_THREAD_POOL_H
+#define BIGINT_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Opt-in work-stealing thread pool for the multiplication kernels.
+ *
+ * While the pool is running, multiplications of at least
+ * bigint_kernels::PARALLEL_THRESHOLD limbs compute their independent sub-products
+ * (the Karatsuba halves, the Toom pointwise products and the three NTT primes) as tasks.
+ * Each worker keeps its own deque, taking its newest task first and stealing the oldest
+ * from the others when it runs dry. Threads that wait for a task group run queued tasks
+ * in the meantime, so nested groups never block the pool. When the pool is stopped,
+ * everything runs serially on the calling thread, as before.
+ */
+class BigIntThreadPool {
+public:
+    /**
+     * @brief A set of tasks that are waited for together.
+     */
+    class TaskGroup {
+    public:
+        TaskGroup();
+
+        /**
+         * @brief Waits for any tasks still pending; their exceptions are dropped.
+         */
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup &) = delete;
+
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        /**
+         * @brief Queues a task, or runs it right away when the pool is stopped.
+         * @param task The work; it must stay valid until wait() returns.
+         */
+        void spawn(std::function<void()> task);
+
+        /**
+         * @brief Runs queued tasks until every task of the group has finished.
+         * @throws The first exception thrown by one of the group's tasks.
+         */
+        void wait();
+
+    private:
+        friend class BigIntThreadPool;
+
+        BigIntThreadPool *pool;
+        std::atomic<std::size_t> pending;
+        std::mutex errorLock;
+        std::exception_ptr error;
+    };
+
+    /**
+     * @brief Starts the shared pool, replacing a running one.
+     * @param threads Number of worker threads; 0 uses one per hardware thread.
+     */
+    static void start(unsigned threads = 0);
+
+    /**
+     * @brief Stops the shared pool; must not be called while a multiplication is running.
+     */
+    static void stop();
+
+    /**
+     * @brief Checks whether parallel multiplication is enabled.
+     * @return True while the shared pool is running.
+     */
+    static bool running();
+
+    /**
+     * @brief Number of worker threads of the shared pool.
+     * @return The worker count, or 0 when the pool is stopped.
+     */
+    static unsigned size();
+
+    ~BigIntThreadPool();
+
+private:
+    struct Task {
+        std::function<void()> run;
+        TaskGroup *group;
+    };
+
+    struct Worker {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    explicit BigIntThreadPool(unsigned threads);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    // Tasks spawned by threads outside the pool
+    std::mutex injectedLock;
+    std::deque<Task> injected;
+
+    // Sleeping workers wait here until something is queued
+    std::mutex sleepLock;
+    std::condition_variable wakeup;
+    std::atomic<std::size_t> queued;
+    std::atomic<bool> stopping;
+
+    void push(Task task);
+
+    bool findTask(Task &task);
+
+    static void execute(Task &task);
+
+    void workerLoop(std::size_t index);
+
+    int currentWorker() const;
+};
+
+#endif // BIGINT_THREAD_POOL_H
@@ -0,0 +1,563 @@
+#ifndef FIXED_BIGINT_H
+#define FIXED_BIGINT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "BigInt.h"
+
+/**
+ * @brief An unsigned integer of exactly Bits bits, stored inline as Bits / 64 limbs.
+ *
+ * Arithmetic wraps around modulo 2^Bits like the built-in unsigned types, so there is no
+ * sign, normalisation or heap storage. The limb count is a template parameter, so the
+ * addition, subtraction, multiplication and bitwise loops are unrolled at compile time
+ * with index sequences. Conversions to and from BigInt are explicit; a negative BigInt
+ * converts to its two's complement modulo 2^Bits.
+ *
+ * Everything apart from the BigInt, string and stream conversions is constexpr, so
+ * constant tables can be computed by the compiler and stored in the binary. The _big
+ * literal in bigint_literals parses at compile time:
+ *
+ *     FixedBigInt<512> x = a * b + c;              // all mod 2^512
+ *     FixedBigInt<1024> full = a.multiplyFull(b);  // not truncated
+ *     BigInt big = static_cast<BigInt>(x);
+ *
+ *     using namespace bigint_literals;
+ *     constexpr auto p = 0xffffffff00000001_big;   // FixedBigInt<64>
+ *     constexpr FixedBigInt<256> tenTo60 = FixedBigInt<256>(10).pow(60);
+ */
+template <std::size_t Bits>
+class FixedBigInt {
+    static_assert(Bits > 0 && Bits % 64 == 0, "FixedBigInt needs a positive multiple of 64 bits");
+
+public:
+    using Limb = std::uint64_t;
+
+    /**
+     * @brief Number of limbs, least significant first.
+     */
+    static constexpr std::size_t LIMBS = Bits / 64;
+
+    //=================== Constructors ===================
+    /**
+     * @brief Initializes the value to zero.
+     */
+    constexpr FixedBigInt() : limbs() {}
+
+    /**
+     * @brief Converts a built-in integer; negative values are sign-extended, so they
+     *        wrap around to 2^Bits - |value|.
+     * @param value The integer.
+     */
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    constexpr FixedBigInt(T value) : limbs() {
+        // The conversion to 128 bits already sign-extends; the fill extends it further
+        unsigned __int128 wide = static_cast<unsigned __int128>(value);
+        Limb fill = std::is_signed<T>::value && (wide >> 127) != 0 ? ~Limb(0) : 0;
+        for (std::size_t i = 0; i < LIMBS; ++i) {
+            limbs[i] = i < 2 ? static_cast<Limb>(wide >> (64 * i)) : fill;
+        }
+    }
+
+    /**
+     * @brief Converts a BigInt modulo 2^Bits.
+     * @param value The BigInt; a negative one becomes its two's complement.
+     */
+    explicit FixedBigInt(const BigInt &value) : limbs() {
+        for (std::size_t i = 0; i < LIMBS && i < value.limbs.size(); ++i) {
+            limbs[i] = value.limbs[i];
+        }
+        if (value.isNegative) {
+            *this = -*this;
+        }
+    }
+
+    /**
+     * @brief Parses a decimal string modulo 2^Bits.
+     * @param num A string representation of an integer.
+     * @throws std::invalid_argument If the string is not a valid representation of an integer.
+     */
+    explicit FixedBigInt(const std::string &num) : FixedBigInt(BigInt(num)) {}
+
+    /**
+     * @brief Converts from another width, dropping or zero-filling the top limbs.
+     * @param other The value to convert.
+     */
+    template <std::size_t OtherBits>
+    constexpr explicit FixedBigInt(const FixedBigInt<OtherBits> &other) : limbs() {
+        for (std::size_t i = 0; i < LIMBS && i < FixedBigInt<OtherBits>::LIMBS; ++i) {
+            limbs[i] = other.limb(i);
+        }
+    }
+
+    //=================== Conversions ===================
+    /**
+     * @brief Converts to a non-negative BigInt.
+     */
+    explicit operator BigInt() const {
+        BigInt result;
+        std::size_t size = significantLimbs();
+        result.limbs.resize(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            result.limbs[i] = limbs[i];
+        }
+        return result;
+    }
+
+    std::string toString() const { return static_cast<BigInt>(*this).toString(); }
+
+    /**
+     * @brief Limb access, least significant first.
+     */
+    constexpr Limb limb(std::size_t index) const { return limbs[index]; }
+
+    //=================== Arithmetic Operators ===================
+    constexpr FixedBigInt operator+(const FixedBigInt &other) const { return FixedBigInt(*this) += other; }
+
+    constexpr FixedBigInt operator-(const FixedBigInt &other) const { return FixedBigInt(*this) -= other; }
+
+    constexpr FixedBigInt operator*(const FixedBigInt &other) const {
+        FixedBigInt result;
+        multiplyLow(result.limbs, limbs, other.limbs);
+        return result;
+    }
+
+    constexpr FixedBigInt &operator+=(const FixedBigInt &other) {
+        Limb carry = 0;
+        unroll<LIMBS>([&](auto i) {
+            DoubleLimb sum = static_cast<DoubleLimb>(limbs[i]) + other.limbs[i] + carry;
+            limbs[i] = static_cast<Limb>(sum);
+            carry = static_cast<Limb>(sum >> 64);
+        });
+        return *this;
+    }
+
+    constexpr FixedBigInt &operator-=(const FixedBigInt &other) {
+        Limb borrow = 0;
+        unroll<LIMBS>([&](auto i) {
+            DoubleLimb difference = static_cast<DoubleLimb>(limbs[i]) - other.limbs[i] - borrow;
+            limbs[i] = static_cast<Limb>(difference);
+            borrow = static_cast<Limb>(difference >> 64) & 1;
+        });
+        return *this;
+    }
+
+    constexpr FixedBigInt &operator*=(const FixedBigInt &other) { return *this = *this * other; }
+
+    /**
+     * @brief The full product, twice as wide, so nothing wraps around.
+     * @param other The other factor.
+     * @return The product as a FixedBigInt<2 * Bits>.
+     */
+    constexpr FixedBigInt<2 * Bits> multiplyFull(const FixedBigInt &other) const {
+        std::array<Limb, 2 * LIMBS> r{};
+        unroll<LIMBS>([&](auto i) {
+            Limb carry = 0;
+            unroll<LIMBS>([&](auto j) {
+                DoubleLimb t = static_cast<DoubleLimb>(limbs[i]) * other.limbs[j] + r[i + j] + carry;
+                r[i + j] = static_cast<Limb>(t);
+                carry = static_cast<Limb>(t >> 64);
+            });
+            r[i + LIMBS] = carry;
+        });
+        return FixedBigInt<2 * Bits>::fromLimbs(r);
+    }
+
+    /**
+     * @brief Power by repeated squaring, modulo 2^Bits.
+     * @param exponent The exponent.
+     * @return The value raised to the exponent; 1 for exponent 0.
+     */
+    constexpr FixedBigInt pow(unsigned exponent) const {
+        FixedBigInt result(1);
+        FixedBigInt base = *this;
+        while (exponent > 0) {
+            if (exponent % 2 == 1) {
+                result *= base;
+            }
+            exponent /= 2;
+            if (exponent > 0) {
+                base *= base;
+            }
+        }
+        return result;
+    }
+
+    //=================== Division and Remainder Operators ===================
+    /**
+     * @throws std::runtime_error If the divisor is zero.
+     */
+    constexpr FixedBigInt operator/(const FixedBigInt &other) const { return divmod(other).first; }
+
+    /**
+     * @throws std::runtime_error If the divisor is zero.
+     */
+    constexpr FixedBigInt operator%(const FixedBigInt &other) const { return divmod(other).second; }
+
+    constexpr FixedBigInt &operator/=(const FixedBigInt &other) { return *this = divmod(other).first; }
+
+    constexpr FixedBigInt &operator%=(const FixedBigInt &other) { return *this = divmod(other).second; }
+
+    /**
+     * @brief Quotient and remainder by Knuth's algorithm D on the significant limbs.
+     * @param other The divisor.
+     * @return The pair (quotient, remainder).
+     * @throws std::runtime_error If the divisor is zero.
+     */
+    constexpr std::pair<FixedBigInt, FixedBigInt> divmod(const FixedBigInt &other) const {
+        std::size_t n = other.significantLimbs();
+        if (n == 0) {
+            throw std::runtime_error("Division by zero");
+        }
+        FixedBigInt quotient;
+        FixedBigInt remainder;
+        if (*this < other) {
+            remainder = *this;
+            return std::make_pair(quotient, remainder);
+        }
+        std::size_t m = significantLimbs();
+        if (n == 1) {
+            Limb divisor = other.limbs[0];
+            Limb rest = 0;
+            for (std::size_t i = m; i-- > 0;) {
+                DoubleLimb current = (static_cast<DoubleLimb>(rest) << 64) | limbs[i];
+                quotient.limbs[i] = static_cast<Limb>(current / divisor);
+                rest = static_cast<Limb>(current % divisor);
+            }
+            remainder.limbs[0] = rest;
+            return std::make_pair(quotient, remainder);
+        }
+
+        // Normalise so the top divisor limb has its high bit set
+        unsigned shift = static_cast<unsigned>(__builtin_clzll(other.limbs[n - 1]));
+        std::array<Limb, LIMBS> v{};
+        std::array<Limb, LIMBS + 1> u{};
+        for (std::size_t i = n; i-- > 0;) {
+            v[i] = shiftedLimb(other.limbs, i, shift);
+        }
+        u[m] = shift == 0 ? 0 : limbs[m - 1] >> (64 - shift);
+        for (std::size_t i = m; i-- > 0;) {
+            u[i] = shiftedLimb(limbs, i, shift);
+        }
+
+        const DoubleLimb base = static_cast<DoubleLimb>(1) << 64;
+        for (std::size_t j = m - n + 1; j-- > 0;) {
+            // Estimate the quotient digit from the top two limbs of the current window
+            DoubleLimb numerator = (static_cast<DoubleLimb>(u[j + n]) << 64) | u[j + n - 1];
+            DoubleLimb qhat = u[j + n] >= v[n - 1] ? base - 1 : numerator / v[n - 1];
+            DoubleLimb rhat = numerator - qhat * v[n - 1];
+            while (rhat < base && qhat * v[n - 2] > ((rhat << 64) | u[j + n - 2])) {
+                --qhat;
+                rhat += v[n - 1];
+            }
+
+            // Multiply and subtract; an overshoot by one shows up as a borrow
+            Limb carry = 0;
+            Limb borrow = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                DoubleLimb product = qhat * v[i] + carry;
+                carry = static_cast<Limb>(product >> 64);
+                DoubleLimb difference = static_cast<DoubleLimb>(u[i + j]) - static_cast<Limb>(product) - borrow;
+                u[i + j] = static_cast<Limb>(difference);
+                borrow = static_cast<Limb>(difference >> 64) & 1;
+            }
+            DoubleLimb top = static_cast<DoubleLimb>(u[j + n]) - carry - borrow;
+            u[j + n] = static_cast<Limb>(top);
+            if ((top >> 64) != 0) {
+                --qhat;
+                Limb addCarry = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    DoubleLimb sum = static_cast<DoubleLimb>(u[i + j]) + v[i] + addCarry;
+                    u[i + j] = static_cast<Limb>(sum);
+                    addCarry = static_cast<Limb>(sum >> 64);
+                }
+                u[j + n] += addCarry;
+            }
+            quotient.limbs[j] = static_cast<Limb>(qhat);
+        }
+
+        // Undo the normalisation on the remainder
+        for (std::size_t i = 0; i < n; ++i) {
+            remainder.limbs[i] = shift == 0 ? u[i] : (u[i] >> shift) | (u[i + 1] << (64 - shift));
+        }
+        return std::make_pair(quotient, remainder);
+    }
+
+    //=================== Unary Operators ===================
+    constexpr FixedBigInt operator+() const { return *this; }
+
+    /**
+     * @brief Two's complement negation, 2^Bits - value.
+     */
+    constexpr FixedBigInt operator-() const { return FixedBigInt() - *this; }
+
+    //=================== Increment and Decrement Operators ===================
+    constexpr FixedBigInt &operator++() { return *this += FixedBigInt(1); }
+
+    constexpr FixedBigInt operator++(int) {
+        FixedBigInt temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    constexpr FixedBigInt &operator--() { return *this -= FixedBigInt(1); }
+
+    constexpr FixedBigInt operator--(int) {
+        FixedBigInt temp = *this;
+        --*this;
+        return temp;
+    }
+
+    //=================== Comparison Operators ===================
+    constexpr bool operator==(const FixedBigInt &other) const { return compare(other) == 0; }
+
+    constexpr bool operator!=(const FixedBigInt &other) const { return compare(other) != 0; }
+
+    constexpr bool operator<(const FixedBigInt &other) const { return compare(other) < 0; }
+
+    constexpr bool operator<=(const FixedBigInt &other) const { return compare(other) <= 0; }
+
+    constexpr bool operator>(const FixedBigInt &other) const { return compare(other) > 0; }
+
+    constexpr bool operator>=(const FixedBigInt &other) const { return compare(other) >= 0; }
+
+    //=================== Bitwise Operators ===================
+    constexpr FixedBigInt operator&(const FixedBigInt &other) const { return FixedBigInt(*this) &= other; }
+
+    constexpr FixedBigInt operator|(const FixedBigInt &other) const { return FixedBigInt(*this) |= other; }
+
+    constexpr FixedBigInt operator^(const FixedBigInt &other) const { return FixedBigInt(*this) ^= other; }
+
+    constexpr FixedBigInt &operator&=(const FixedBigInt &other) {
+        unroll<LIMBS>([&](auto i) { limbs[i] &= other.limbs[i]; });
+        return *this;
+    }
+
+    constexpr FixedBigInt &operator|=(const FixedBigInt &other) {
+        unroll<LIMBS>([&](auto i) { limbs[i] |= other.limbs[i]; });
+        return *this;
+    }
+
+    constexpr FixedBigInt &operator^=(const FixedBigInt &other) {
+        unroll<LIMBS>([&](auto i) { limbs[i] ^= other.limbs[i]; });
+        return *this;
+    }
+
+    constexpr FixedBigInt operator~() const {
+        FixedBigInt result;
+        unroll<LIMBS>([&](auto i) { result.limbs[i] = ~limbs[i]; });
+        return result;
+    }
+
+    /**
+     * @brief Shifts left, dropping the bits pushed past the top; bits >= Bits gives zero.
+     */
+    constexpr FixedBigInt operator<<(std::size_t bits) const { return FixedBigInt(*this) <<= bits; }
+
+    /**
+     * @brief Logical right shift; bits >= Bits gives zero.
+     */
+    constexpr FixedBigInt operator>>(std::size_t bits) const { return FixedBigInt(*this) >>= bits; }
+
+    constexpr FixedBigInt &operator<<=(std::size_t bits) {
+        std::size_t limbShift = bits / 64;
+        unsigned bitShift = static_cast<unsigned>(bits % 64);
+        for (std::size_t i = LIMBS; i-- > 0;) {
+            limbs[i] = i < limbShift ? 0 : shiftedLimb(limbs, i - limbShift, bitShift);
+        }
+        return *this;
+    }
+
+    constexpr FixedBigInt &operator>>=(std::size_t bits) {
+        std::size_t limbShift = bits / 64;
+        unsigned bitShift = static_cast<unsigned>(bits % 64);
+        for (std::size_t i = 0; i < LIMBS; ++i) {
+            std::size_t from = i + limbShift;
+            if (from >= LIMBS) {
+                limbs[i] = 0;
+            } else if (bitShift == 0) {
+                limbs[i] = limbs[from];
+            } else {
+                limbs[i] = (limbs[from] >> bitShift) | (from + 1 < LIMBS ? limbs[from + 1] << (64 - bitShift) : 0);
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Position of the highest set bit plus one; zero for zero.
+     */
+    constexpr std::size_t bitLength() const {
+        std::size_t size = significantLimbs();
+        return size == 0 ? 0 : 64 * size - static_cast<std::size_t>(__builtin_clzll(limbs[size - 1]));
+    }
+
+    constexpr bool testBit(std::size_t index) const { return index < Bits && (limbs[index / 64] >> (index % 64) & 1); }
+
+    //=================== I/O Stream Overloads ===================
+    friend std::ostream &operator<<(std::ostream &out, const FixedBigInt &value) {
+        return out << static_cast<BigInt>(value);
+    }
+
+    friend std::istream &operator>>(std::istream &in, FixedBigInt &value) {
+        BigInt parsed;
+        if (in >> parsed) {
+            value = FixedBigInt(parsed);
+        }
+        return in;
+    }
+
+    /**
+     * @brief Builds a value from its limbs, least significant first.
+     */
+    static constexpr FixedBigInt fromLimbs(const std::array<Limb, LIMBS> &limbs) {
+        FixedBigInt result;
+        result.limbs = limbs;
+        return result;
+    }
+
+private:
+    using DoubleLimb = unsigned __int128;
+
+    std::array<Limb, LIMBS> limbs;
+
+    /**
+     * @brief Calls f(std::integral_constant<std::size_t, I>()) for I = 0 .. N - 1 as one
+     *        fold expression, so the loop body is instantiated N times with constant
+     *        indices instead of being run as a loop.
+     */
+    template <std::size_t N, typename F>
+    static constexpr void unroll(F &&f) {
+        unrollSequence(f, std::make_index_sequence<N>());
+    }
+
+    template <typename F, std::size_t... I>
+    static constexpr void unrollSequence(F &f, std::index_sequence<I...>) {
+        (void) f;  // Unused when the sequence is empty
+        (f(std::integral_constant<std::size_t, I>()), ...);
+    }
+
+    /**
+     * @brief The low LIMBS limbs of a * b; the row of a[i] only needs LIMBS - i limbs of b.
+     */
+    static constexpr void multiplyLow(std::array<Limb, LIMBS> &r, const std::array<Limb, LIMBS> &a,
+                                      const std::array<Limb, LIMBS> &b) {
+        unroll<LIMBS>([&](auto i) {
+            Limb carry = 0;
+            unroll<LIMBS - decltype(i)::value>([&](auto j) {
+                DoubleLimb t = static_cast<DoubleLimb>(a[i]) * b[j] + r[i + j] + carry;
+                r[i + j] = static_cast<Limb>(t);
+                carry = static_cast<Limb>(t >> 64);
+            });
+        });
+    }
+
+    /**
+     * @brief Limb i of the limbs shifted left by shift < 64 bits.
+     */
+    template <std::size_t N>
+    static constexpr Limb shiftedLimb(const std::array<Limb, N> &limbs, std::size_t i, unsigned shift) {
+        if (shift == 0) {
+            return limbs[i];
+        }
+        return (limbs[i] << shift) | (i > 0 ? limbs[i - 1] >> (64 - shift) : 0);
+    }
+
+    constexpr std::size_t significantLimbs() const {
+        std::size_t size = LIMBS;
+        while (size > 0 && limbs[size - 1] == 0) {
+            --size;
+        }
+        return size;
+    }
+
+    constexpr int compare(const FixedBigInt &other) const {
+        for (std::size_t i = LIMBS; i-- > 0;) {
+            if (limbs[i] != other.limbs[i]) {
+                return limbs[i] < other.limbs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+};
+
+/**
+ * @brief The _big literal: an integer literal of any length, parsed by the compiler into
+ *        the narrowest FixedBigInt that holds it. Decimal, 0x hex, 0b binary and
+ *        leading-zero octal are accepted, with ' digit separators.
+ */
+namespace bigint_literals {
+    namespace detail {
+        template <std::size_t N>
+        constexpr unsigned literalBase(const std::array<char, N> &text) {
+            if (N > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+                return 16;
+            }
+            if (N > 2 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B')) {
+                return 2;
+            }
+            return N > 1 && text[0] == '0' ? 8 : 10;
+        }
+
+        constexpr unsigned digitValue(char c) {
+            if (c >= '0' && c <= '9') {
+                return static_cast<unsigned>(c - '0');
+            }
+            if (c >= 'a' && c <= 'f') {
+                return static_cast<unsigned>(c - 'a' + 10);
+            }
+            if (c >= 'A' && c <= 'F') {
+                return static_cast<unsigned>(c - 'A' + 10);
+            }
+            return 16;
+        }
+
+        /**
+         * @brief Bits for the literal rounded up to whole limbs; log2(10) < 10 / 3 bounds
+         *        the decimal case.
+         */
+        template <std::size_t N>
+        constexpr std::size_t literalBits(const std::array<char, N> &text) {
+            unsigned base = literalBase(text);
+            std::size_t digits = 0;
+            for (std::size_t i = base == 16 || base == 2 ? 2 : 0; i < N; ++i) {
+                digits += text[i] != '\'' ? 1 : 0;
+            }
+            std::size_t bits = base == 16 ? 4 * digits : base == 8 ? 3 * digits : base == 2 ? digits
+                                                                                    : (10 * digits + 2) / 3;
+            return bits <= 64 ? 64 : (bits + 63) / 64 * 64;
+        }
+
+        template <std::size_t Bits, std::size_t N>
+        constexpr FixedBigInt<Bits> parseLiteral(const std::array<char, N> &text) {
+            unsigned base = literalBase(text);
+            std::size_t start = base == 16 || base == 2 ? 2 : 0;
+            FixedBigInt<Bits> result;
+            for (std::size_t i = start; i < N; ++i) {
+                if (text[i] == '\'') {
+                    continue;
+                }
+                unsigned digit = digitValue(text[i]);
+                if (digit >= base) {
+                    throw std::invalid_argument("Invalid digit in _big literal");
+                }
+                result = result * FixedBigInt<Bits>(base) + FixedBigInt<Bits>(digit);
+            }
+            return result;
+        }
+    }
+
+    template <char... Digits>
+    constexpr auto operator""_big() {
+        constexpr std::array<char, sizeof...(Digits)> text{Digits...};
+        return detail::parseLiteral<detail::literalBits(text)>(text);
+    }
+}
+
+#endif // FIXED_BIGINT_H
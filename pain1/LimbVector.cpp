@@ -0,0 +1,162 @@
+#include "LimbVector.h"
+#include <algorithm>
+#include <utility>
+
+//========== Constructors ==========
+
+/**
+ * @brief Creates an empty vector using the inline storage.
+ */
+LimbVector::LimbVector() noexcept: storage(local), length(0), allocated(INLINE_LIMBS) {}
+
+/**
+ * @brief Creates a vector of count zero limbs.
+ * @param count Number of limbs.
+ */
+LimbVector::LimbVector(std::size_t count) : LimbVector() {
+    resize(count);
+}
+
+/**
+ * @brief Copy constructor; the copy is inline whenever the limbs fit.
+ * @param other LimbVector to copy.
+ */
+LimbVector::LimbVector(const LimbVector &other) : LimbVector() {
+    reserve(other.length);
+    std::copy(other.storage, other.storage + other.length, storage);
+    length = other.length;
+}
+
+/**
+ * @brief Move constructor. Takes over a heap block, or copies inline limbs.
+ * @param other LimbVector to move from; left empty.
+ */
+LimbVector::LimbVector(LimbVector &&other) noexcept: LimbVector() {
+    *this = std::move(other);
+}
+
+//========== Destructor ==========
+
+/**
+ * @brief Releases the heap block, if any.
+ */
+LimbVector::~LimbVector() {
+    if (!isInline()) {
+        delete[] storage;
+    }
+}
+
+//========== Assignment Operators ==========
+
+/**
+ * @brief Copy assignment operator; reuses the current storage when it is large enough.
+ * @param other LimbVector to copy from.
+ * @return Reference to the current instance.
+ */
+LimbVector &LimbVector::operator=(const LimbVector &other) {
+    if (this != &other) {
+        length = 0;
+        reserve(other.length);
+        std::copy(other.storage, other.storage + other.length, storage);
+        length = other.length;
+    }
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator. Takes over a heap block, or copies inline limbs.
+ * @param other LimbVector to move from; left empty.
+ * @return Reference to the current instance.
+ */
+LimbVector &LimbVector::operator=(LimbVector &&other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.isInline()) {
+        // Inline limbs always fit in the current storage
+        std::copy(other.storage, other.storage + other.length, storage);
+        length = other.length;
+    } else {
+        if (!isInline()) {
+            delete[] storage;
+        }
+        storage = other.storage;
+        length = other.length;
+        allocated = other.allocated;
+        other.storage = other.local;
+        other.allocated = INLINE_LIMBS;
+    }
+    other.length = 0;
+    return *this;
+}
+
+//========== Capacity and Modifiers ==========
+
+/**
+ * @brief Makes room for at least count limbs without changing the size.
+ * @param count Number of limbs to make room for.
+ */
+void LimbVector::reserve(std::size_t count) {
+    if (count > allocated) {
+        grow(count);
+    }
+}
+
+/**
+ * @brief Changes the number of limbs; new limbs are set to value.
+ * @param count New number of limbs.
+ * @param value Value for the added limbs.
+ */
+void LimbVector::resize(std::size_t count, Limb value) {
+    reserve(count);
+    if (count > length) {
+        std::fill(storage + length, storage + count, value);
+    }
+    length = count;
+}
+
+/**
+ * @brief Replaces the contents with count copies of value.
+ * @param count New number of limbs.
+ * @param value Value for every limb.
+ */
+void LimbVector::assign(std::size_t count, Limb value) {
+    length = 0;
+    resize(count, value);
+}
+
+/**
+ * @brief Moves the limbs to a heap block of at least minimum limbs, growing
+ *        geometrically so repeated push_back stays amortised constant time.
+ * @param minimum Required capacity.
+ */
+void LimbVector::grow(std::size_t minimum) {
+    std::size_t expanded = std::max(minimum, 2 * allocated);
+    Limb *block = new Limb[expanded];
+    std::copy(storage, storage + length, block);
+    if (!isInline()) {
+        delete[] storage;
+    }
+    storage = block;
+    allocated = expanded;
+}
+
+//========== Comparison ==========
+
+/**
+ * @brief Checks whether both vectors hold the same limbs.
+ * @param other LimbVector to compare with.
+ * @return True if the sizes and all limbs match.
+ */
+bool LimbVector::operator==(const LimbVector &other) const {
+    return length == other.length && std::equal(storage, storage + length, other.storage);
+}
+
+/**
+ * @brief Checks whether the vectors differ.
+ * @param other LimbVector to compare with.
+ * @return True if the sizes or any limb differ.
+ */
+bool LimbVector::operator!=(const LimbVector &other) const {
+    return !(*this == other);
+}
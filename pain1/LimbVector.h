@@ -0,0 +1,104 @@
+#ifndef LIMBVECTOR_H
+#define LIMBVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief A growable array of limbs that keeps up to INLINE_LIMBS of them inside the object
+ *        and only moves to the heap when a value outgrows that.
+ *
+ * It offers the subset of the std::vector interface BigInt relies on. New limbs from
+ * resize() are zero unless another value is given.
+ */
+class LimbVector {
+public:
+    using Limb = std::uint64_t;
+
+    /**
+     * @brief Number of limbs stored without allocating; enough for the product of two
+     *        128-bit values.
+     */
+    static constexpr std::size_t INLINE_LIMBS = 4;
+
+    //=================== Constructors ===================
+    LimbVector() noexcept;
+
+    explicit LimbVector(std::size_t count);
+
+    LimbVector(const LimbVector &other);
+
+    LimbVector(LimbVector &&other) noexcept;
+
+    //=================== Destructor ===================
+    ~LimbVector();
+
+    //=================== Assignment Operators ===================
+    LimbVector &operator=(const LimbVector &other);
+
+    LimbVector &operator=(LimbVector &&other) noexcept;
+
+    //=================== Element Access ===================
+    Limb *data() { return storage; }
+
+    const Limb *data() const { return storage; }
+
+    Limb &operator[](std::size_t index) { return storage[index]; }
+
+    const Limb &operator[](std::size_t index) const { return storage[index]; }
+
+    Limb &back() { return storage[length - 1]; }
+
+    const Limb &back() const { return storage[length - 1]; }
+
+    Limb *begin() { return storage; }
+
+    const Limb *begin() const { return storage; }
+
+    Limb *end() { return storage + length; }
+
+    const Limb *end() const { return storage + length; }
+
+    //=================== Capacity ===================
+    std::size_t size() const { return length; }
+
+    bool empty() const { return length == 0; }
+
+    std::size_t capacity() const { return allocated; }
+
+    void reserve(std::size_t count);
+
+    //=================== Modifiers ===================
+    void push_back(Limb limb) {
+        if (length == allocated) {
+            grow(length + 1);
+        }
+        storage[length++] = limb;
+    }
+
+    void pop_back() { --length; }
+
+    void clear() { length = 0; }
+
+    void resize(std::size_t count, Limb value = 0);
+
+    void assign(std::size_t count, Limb value);
+
+    //=================== Comparison ===================
+    bool operator==(const LimbVector &other) const;
+
+    bool operator!=(const LimbVector &other) const;
+
+private:
+    // Points at local while the limbs fit, otherwise at a heap block of allocated limbs
+    Limb *storage;
+    std::size_t length;
+    std::size_t allocated;
+    Limb local[INLINE_LIMBS];
+
+    bool isInline() const { return storage == local; }
+
+    void grow(std::size_t minimum);
+};
+
+#endif // LIMBVECTOR_H
@@ -1,8 +1,21 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include "BigInt.h"
+#include "BigIntArena.h"
+#include "BigIntExpression.h"
+#include "BigIntModular.h"
+#include "BigIntSerialization.h"
+#include "BigIntThreadPool.h"
+#include "FixedBigInt.h"
+#include "LimbVector.h"
 
 uint32_t factorial(uint32_t number) {
     return number <= 1 ? number : factorial(number - 1) * number;
@@ -228,3 +241,715 @@ TEST_CASE("String Conversion", "[BigInt]") {
 }
 
 
+//Limb Boundaries:
+TEST_CASE("Limb Boundaries", "[BigInt]") {
+    BigInt maxLimb("18446744073709551615");  // 2^64 - 1
+    BigInt one(1);
+    REQUIRE((maxLimb + one).toString() == "18446744073709551616");
+    REQUIRE((maxLimb + one - one).toString() == "18446744073709551615");
+    REQUIRE((maxLimb * maxLimb).toString() == "340282366920938463426481119284349108225");
+    REQUIRE(BigInt("-0000").toString() == "0");
+    REQUIRE(BigInt("0000012345678901234567890123").toString() == "12345678901234567890123");
+}
+//Compound Assignment:
+TEST_CASE("Compound Assignment In Place", "[BigInt]") {
+    BigInt num("18446744073709551615");
+    num += num;  // Aliased operands
+    REQUIRE(num.toString() == "36893488147419103230");
+    num -= BigInt("36893488147419103231");
+    REQUIRE(num.toString() == "-1");
+    num += BigInt("340282366920938463463374607431768211456");
+    REQUIRE(num.toString() == "340282366920938463463374607431768211455");
+    num -= num;
+    REQUIRE(num.toString() == "0");
+}
+//Karatsuba Range:
+TEST_CASE("Multiplication Above Karatsuba Threshold", "[BigInt]") {
+    // (10^1000 - 1)^2 = 99..9800..01 and (10^1000 - 1)(10^3000 - 1) = 99..9899..9900..01
+    BigInt a(std::string(1000, '9'));
+    BigInt b(std::string(3000, '9'));
+    REQUIRE((a * a).toString() == std::string(999, '9') + "8" + std::string(999, '0') + "1");
+    REQUIRE((a * b).toString() == std::string(999, '9') + "8" + std::string(2000, '9') + std::string(999, '0') + "1");
+    REQUIRE((b * a) == (a * b));
+}
+//Toom-Cook Range:
+TEST_CASE("Multiplication Above Toom-3 Threshold", "[BigInt]") {
+    // Same identities as above, with operands long enough for the balanced and 3x2 Toom splits
+    BigInt a(std::string(30000, '9'));
+    BigInt b(std::string(50000, '9'));
+    REQUIRE((a * a).toString() == std::string(29999, '9') + "8" + std::string(29999, '0') + "1");
+    REQUIRE((a * b).toString() == std::string(29999, '9') + "8" + std::string(20000, '9') + std::string(29999, '0') + "1");
+}
+//NTT Range:
+TEST_CASE("Multiplication Above NTT Threshold", "[BigInt]") {
+    BigInt a(std::string(80000, '9'));
+    BigInt b(std::string(90000, '9'));
+    REQUIRE((a * a).toString() == std::string(79999, '9') + "8" + std::string(79999, '0') + "1");
+    REQUIRE((a * b).toString() == std::string(79999, '9') + "8" + std::string(10000, '9') + std::string(79999, '0') + "1");
+}
+//Squaring:
+TEST_CASE("Squaring", "[BigInt]") {
+    BigInt num("-12345678901234567890");
+    REQUIRE(num.square().toString() == "152415787532388367501905199875019052100");
+    REQUIRE(num.square() == num * BigInt("-12345678901234567890"));
+    BigInt nines(std::string(3000, '9'));
+    REQUIRE(nines.square().toString() == std::string(2999, '9') + "8" + std::string(2999, '0') + "1");
+    BigInt copy = nines;
+    copy *= copy;
+    REQUIRE(copy == nines.square());
+    REQUIRE(BigInt(3).pow(100).toString() == "515377520732011331036461129765621272702107522001");
+}
+//Squaring With Opposite Signs:
+TEST_CASE("Equal Magnitudes With Opposite Signs", "[BigInt]") {
+    BigInt pos("18446744073709551616");
+    BigInt neg("-18446744073709551616");
+    REQUIRE((pos * neg).toString() == "-340282366920938463463374607431768211456");
+    REQUIRE((neg * neg).toString() == "340282366920938463463374607431768211456");
+}
+//Long Division:
+TEST_CASE("Long Division", "[BigInt]") {
+    // (10^2000 - 1) / (10^1000 - 1) = 10^1000 + 1 exactly
+    BigInt a(std::string(2000, '9'));
+    BigInt b(std::string(1000, '9'));
+    auto result = a.divmod(b);
+    REQUIRE(result.first.toString() == "1" + std::string(999, '0') + "1");
+    REQUIRE(result.second.toString() == "0");
+
+    BigInt c("-340282366920938463463374607431768211457");  // -(2^128 + 1)
+    auto mixed = c.divmod(BigInt("18446744073709551616"));
+    REQUIRE(mixed.first.toString() == "-18446744073709551616");
+    REQUIRE(mixed.second.toString() == "-1");
+    REQUIRE((mixed.first * BigInt("18446744073709551616") + mixed.second) == c);
+}
+//Recursive Division:
+TEST_CASE("Division Above Recursive Threshold", "[BigInt]") {
+    // 10^60000 + 5 = (10^30000 - 1)(10^30000 + 1) + 6
+    BigInt dividend("1" + std::string(59999, '0') + "5");
+    BigInt divisor(std::string(30000, '9'));
+    auto result = dividend.divmod(divisor);
+    REQUIRE(result.first.toString() == "1" + std::string(29999, '0') + "1");
+    REQUIRE(result.second.toString() == "6");
+    REQUIRE((-dividend) % divisor == BigInt(-6));
+}
+//Scalar Arithmetic:
+TEST_CASE("Scalar Arithmetic", "[BigInt]") {
+    REQUIRE(BigInt(INT32_MIN).toString() == "-2147483648");
+    REQUIRE(BigInt(INT64_MIN).toString() == "-9223372036854775808");
+    REQUIRE(BigInt(UINT64_MAX).toString() == "18446744073709551615");
+    REQUIRE(BigInt(static_cast<unsigned __int128>(UINT64_MAX) + 1).toString() == "18446744073709551616");
+    REQUIRE(BigInt(-static_cast<__int128>(UINT64_MAX) - 1).toString() == "-18446744073709551616");
+
+    BigInt num("-340282366920938463463374607431768211457");  // -(2^128 + 1)
+    REQUIRE((num / 7).toString() == "-48611766702991209066196372490252601636");
+    REQUIRE((num % 7).toString() == "-5");
+    REQUIRE((num / -7LL).toString() == "48611766702991209066196372490252601636");
+    REQUIRE((num % UINT64_MAX).toString() == "-2");
+    REQUIRE((num * -3).toString() == "1020847100762815390390123822295304634371");
+    REQUIRE((num + 2u).toString() == "-340282366920938463463374607431768211455");
+    REQUIRE((BigInt(5) - 7L).toString() == "-2");
+    REQUIRE_THROWS_AS(num / 0, std::runtime_error);
+    REQUIRE_THROWS_AS(num % 0u, std::runtime_error);
+
+    // 128-bit operands are not cut down to a limb, whether or not the dialect counts
+    // them as integral
+    BigInt sum(0);
+    sum += static_cast<__int128>(1) << 100;
+    REQUIRE(sum == BigInt(2).pow(100));
+    sum -= static_cast<unsigned __int128>(1) << 64;
+    REQUIRE(sum == BigInt(2).pow(100) - BigInt(2).pow(64));
+    REQUIRE(BigInt(5) * (static_cast<unsigned __int128>(1) << 70) == BigInt(5) * BigInt(2).pow(70));
+    REQUIRE(BigInt(2).pow(90) / (static_cast<__int128>(1) << 80) == BigInt(1024));
+    REQUIRE(BigInt(1000) / (static_cast<__int128>(1) << 80) == BigInt(0));
+    REQUIRE(BigInt(2).pow(90) % -((static_cast<__int128>(1) << 80) + 1) == BigInt(2).pow(80) - 1023);
+
+    BigInt edge("18446744073709551615");
+    ++edge;
+    REQUIRE(edge.toString() == "18446744073709551616");
+    --edge;
+    REQUIRE(edge.toString() == "18446744073709551615");
+    BigInt zero;
+    --zero;
+    REQUIRE(zero.toString() == "-1");
+    ++zero;
+    REQUIRE(zero.toString() == "0");
+}
+//Recursive Division With Sparse Divisor:
+TEST_CASE("Division By Power Of Ten", "[BigInt]") {
+    // 10^9728 has 152 zero low limbs, which drives the inner steps into their top-limb path
+    BigInt divisor = BigInt(10).pow(9728);
+    auto result = (BigInt(10).pow(50000) - 1).divmod(divisor);
+    REQUIRE(result.first == BigInt(10).pow(50000 - 9728) - 1);
+    REQUIRE(result.second == divisor - 1);
+}
+//Decimal Conversion:
+TEST_CASE("Decimal Conversion Above Radix Threshold", "[BigInt]") {
+    std::string digits;
+    for (int i = 0; i < 20000; ++i) {
+        digits += static_cast<char>('0' + (i * 7 + i / 13) % 10);
+    }
+    digits[0] = '4';
+    REQUIRE(BigInt(digits).toString() == digits);
+    REQUIRE(BigInt("-000" + digits).toString() == "-" + digits);
+    REQUIRE(BigInt(std::string(20000, '9')) + 1 == BigInt(10).pow(20000));
+
+    std::string power = BigInt(2).pow(100000).toString();
+    REQUIRE(power.size() == 30103);
+    REQUIRE(power.substr(0, 20) == "99900209301438450794");
+    REQUIRE(power.substr(30083) == "55304734389883109376");
+}
+//Inline Limb Storage:
+TEST_CASE("Limb Vector Spills To Heap", "[LimbVector]") {
+    LimbVector limbs;
+    for (LimbVector::Limb i = 0; i < 10; ++i) {
+        limbs.push_back(i);
+    }
+    REQUIRE(limbs.size() == 10);
+    REQUIRE(limbs.capacity() >= 10);
+
+    LimbVector copy = limbs;
+    LimbVector moved = std::move(limbs);
+    REQUIRE(limbs.empty());
+    REQUIRE(moved == copy);
+    moved.resize(2);
+    copy = moved;
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy[1] == 1);
+
+    LimbVector small(3);
+    small[2] = 42;
+    LimbVector target(20);
+    target = std::move(small);
+    REQUIRE(target.size() == 3);
+    REQUIRE(target.back() == 42);
+
+    // Values crossing the inline capacity keep their arithmetic exact
+    BigInt word("340282366920938463463374607431768211455");  // 2^128 - 1
+    BigInt wide = word * word;
+    REQUIRE(wide.toString() == "115792089237316195423570985008687907852589419931798687112530834793049593217025");
+    REQUIRE((wide * word) / word == wide);
+    REQUIRE((wide + 1) % word == BigInt(1));
+}
+//Temporary Operands:
+TEST_CASE("Chained Arithmetic On Temporaries", "[BigInt]") {
+    BigInt a("123456789012345678901234567890123456789");
+    BigInt b("-98765432109876543210987654321");
+    BigInt c("55555555555555555555555555555555555555555555");
+
+    // Each form below reuses a temporary on the left, the right or both sides
+    BigInt ab = a + b;
+    BigInt ca = c - a;
+    REQUIRE((a + b) + c == ab + c);
+    REQUIRE(c + (a + b) == c + ab);
+    REQUIRE((c - a) - (a + b) == ca - ab);
+    REQUIRE(a - (c - a) == a - ca);
+    REQUIRE(b - (b + 0) == BigInt(0));
+    REQUIRE((a * b) * (c - a) == (a * b) * ca);
+    REQUIRE(c * (a + b) == c * ab);
+    REQUIRE((c * c) / (a + b) == (c * c) / ab);
+    REQUIRE((c * c) % a == c.square() % a);
+    REQUIRE(-(a * b) == b * -a);
+    REQUIRE((a + b) * 3 - 1 == ab * 3 - 1);
+    REQUIRE((BigInt(5) - BigInt(8)).toString() == "-3");
+}
+//Expression Templates:
+TEST_CASE("Fused Multiply-Add Expressions", "[BigInt]") {
+    using bigint_expr::lazy;
+    BigInt a("-123456789012345678901234567890");
+    BigInt b("98765432109876543210");
+    BigInt c("1219326311370217952237463801111263526900");
+    BigInt d("-340282366920938463463374607431768211457");
+    BigInt m("1000000007");
+
+    BigInt sum = lazy(a) * b + c;
+    REQUIRE(sum == a * b + c);
+    BigInt offset = lazy(a) * b - c;
+    REQUIRE(offset == a * b - c);
+    REQUIRE(BigInt(lazy(b) * b - d) == b * b - d);
+    REQUIRE(BigInt(lazy(c) * c + a) == c * c + a);
+    REQUIRE(BigInt(lazy(a) * a - a) == a * a - a);
+    BigInt difference = lazy(a) * b - lazy(c) * d;
+    REQUIRE(difference == a * b - c * d);
+    BigInt residue = (lazy(b % m) + c % m) % m;
+    REQUIRE(residue == (b + c) % m);
+    REQUIRE(BigInt((lazy(a) + b) % m) == (a + b) % m);
+
+    // Accumulating crosses zero and back, and may alias the destination
+    BigInt acc = c;
+    acc -= lazy(b) * b;
+    REQUIRE(acc == c - b * b);
+    acc += lazy(acc) * a;
+    REQUIRE(acc == (c - b * b) * (a + 1));
+    acc = 5;
+    acc.subtractProduct(b, b);
+    acc.addProduct(b, b);
+    REQUIRE(acc == BigInt(5));
+    REQUIRE_THROWS_AS(BigInt((lazy(a) + b) % BigInt(0)), std::runtime_error);
+}
+//Modular Exponentiation:
+TEST_CASE("Modular Exponentiation", "[BigInt]") {
+    BigInt p("170141183460469231731687303715884105727");  // 2^127 - 1
+    REQUIRE(powMod(BigInt(3), p - 1, p) == BigInt(1));
+    REQUIRE(powMod(BigInt(-7), BigInt("100000000000000000003"), p) ==
+            BigInt("12866685897752854098792551075332139288"));
+
+    // Even moduli, and a negative base reduced into [0, m)
+    REQUIRE(powMod(BigInt(123456789), BigInt(987654321), BigInt(2).pow(100)) ==
+            BigInt("203118105120638269398627100245"));
+    REQUIRE(powMod(BigInt(-2), BigInt(65), BigInt(10).pow(30)) == BigInt("999999999963106511852580896768"));
+    REQUIRE(powMod(BigInt(5), BigInt(0), BigInt(1)) == BigInt(0));
+    REQUIRE(powMod(BigInt(0), BigInt(0), BigInt(7)) == BigInt(1));
+
+    // One context serves several exponentiations and round-trips Montgomery form
+    MontgomeryContext context(BigInt(10).pow(40) + 1);
+    REQUIRE(context.powMod(BigInt(5), BigInt(2).pow(70)) == BigInt("2945104332379951036907882029589466592922"));
+    REQUIRE(context.powMod(BigInt(2), BigInt(3)) == BigInt(8));
+    BigInt x("123456789012345678901234567890");
+    BigInt y("-98765432109876543210");
+    BigInt product = context.multiply(context.toMontgomery(x), context.toMontgomery(y));
+    REQUIRE(context.fromMontgomery(product) == (x * y % context.modulus() + context.modulus()) % context.modulus());
+
+    REQUIRE_THROWS_AS(powMod(BigInt(2), BigInt(-1), p), std::invalid_argument);
+    REQUIRE_THROWS_AS(powMod(BigInt(2), BigInt(3), BigInt(0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(MontgomeryContext(BigInt(10)), std::invalid_argument);
+}
+//Barrett Reduction:
+TEST_CASE("Barrett Reduction", "[BigInt]") {
+    BigInt p = BigInt(2).pow(255) - 19;
+    BarrettReducer reducer(p);
+    REQUIRE(reducer.modulus() == p);
+    REQUIRE(reducer.multiply(p - 5, p - 7) == BigInt(35));
+    REQUIRE(reducer.reduce(BigInt("-12345678901234567890123")) == p - BigInt("12345678901234567890123"));
+    REQUIRE(reducer.reduce(p) == BigInt(0));
+    REQUIRE(reducer.reduce(p * p - 1) == p - 1);
+    REQUIRE(reducer.reduce(BigInt(2).pow(600) + 3) == (BigInt(2).pow(600) + 3) % p);
+
+    // Batch reduction, in place and into a vector, agrees with operator%
+    std::vector<BigInt> values;
+    BigInt x("98765432109876543210987654321");
+    for (int i = 0; i < 20; ++i) {
+        x = x * x + i;
+        values.push_back(i % 2 == 0 ? x : -x);
+    }
+    std::vector<BigInt> reduced = reducer.reduce(values);
+    std::vector<BigInt> inPlace = values;
+    reducer.reduce(inPlace.data(), inPlace.data(), inPlace.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(reduced[i] == (values[i] % p + p) % p);
+        REQUIRE(inPlace[i] == reduced[i]);
+    }
+
+    REQUIRE(BarrettReducer(BigInt(1)).reduce(BigInt(-5)) == BigInt(0));
+    REQUIRE_THROWS_AS(BarrettReducer(BigInt(0)), std::invalid_argument);
+}
+//GCD and Modular Inverse:
+TEST_CASE("GCD and Modular Inverse", "[BigInt]") {
+    BigInt a("1197530853419753085341975308533");  // 12345678901234567890123456789 * 97
+    BigInt b("9580246914658024691370");            // 98765432109876543210 * 97
+    REQUIRE(gcd(a, b) == BigInt(873));
+    REQUIRE(gcd(-a, b) == BigInt(873));
+    REQUIRE(gcd(a, 0) == a);
+    REQUIRE(gcd(0, 0) == BigInt(0));
+
+    BigInt x;
+    BigInt y;
+    BigInt g = extendedGcd(a, -b, x, y);
+    REQUIRE(g == BigInt(873));
+    REQUIRE(a * x + (-b) * y == g);
+    REQUIRE(x >= 0);
+    REQUIRE(x < b / g);
+
+    // Operands large enough for the half-GCD, with a known common factor
+    BigInt p = BigInt(2).pow(521) - 1;
+    BigInt u = BigInt(3).pow(20000) * p;
+    BigInt v = (BigInt(7).pow(11000) + 4) * p;
+    REQUIRE(gcd(u, v) == p);
+    g = extendedGcd(u, v, x, y);
+    REQUIRE(g == p);
+    REQUIRE(u * x + v * y == p);
+
+    BigInt inverse = modInverse(BigInt(3).pow(100) + 7, p);
+    REQUIRE(inverse == BigInt("1361114342941605349799927521013487936268869034009093972652739629594377058040284385485932049262847880427907433287871698748042196242917165431258463803864189832"));
+    REQUIRE(modInverse(BigInt(-3), BigInt(7)) == BigInt(2));
+    REQUIRE_THROWS_AS(modInverse(BigInt(6), BigInt(9)), std::invalid_argument);
+    REQUIRE_THROWS_AS(modInverse(BigInt(1), BigInt(0)), std::invalid_argument);
+}
+
+//Integer Roots:
+TEST_CASE("Integer Roots", "[BigInt]") {
+    BigInt root("123456789012345678901234567890123456789");
+    BigInt square = root.square();
+    REQUIRE(square.isqrt() == root);
+    REQUIRE((square + 1).isqrt() == root);
+    REQUIRE((square - 1).isqrt() == root - 1);
+    REQUIRE(BigInt(0).isqrt() == BigInt(0));
+    REQUIRE(BigInt(15).isqrt() == BigInt(3));
+
+    // Large enough to exercise the recursive starting estimate
+    BigInt big = BigInt(3).pow(5001);
+    BigInt bigRoot = big.isqrt();
+    REQUIRE(bigRoot.square() <= big);
+    REQUIRE((bigRoot + 1).square() > big);
+
+    BigInt cube = root.pow(3);
+    REQUIRE(cube.iroot(3) == root);
+    REQUIRE((cube - 1).iroot(3) == root - 1);
+    REQUIRE((-cube).iroot(3) == -root);
+    REQUIRE(root.pow(5).iroot(5) == root);
+    REQUIRE(BigInt(1000).iroot(1) == BigInt(1000));
+    REQUIRE(BigInt(2).pow(300).iroot(100) == BigInt(8));
+
+    REQUIRE(square.isPerfectSquare());
+    REQUIRE(BigInt(0).isPerfectSquare());
+    REQUIRE_FALSE((square + 1).isPerfectSquare());
+    REQUIRE_FALSE((square - 1).isPerfectSquare());
+    REQUIRE_FALSE(BigInt(-4).isPerfectSquare());
+
+    REQUIRE_THROWS_AS(BigInt(-1).isqrt(), std::invalid_argument);
+    REQUIRE_THROWS_AS(BigInt(-8).iroot(2), std::invalid_argument);
+    REQUIRE_THROWS_AS(BigInt(8).iroot(0), std::invalid_argument);
+}
+
+//Bitwise Operators:
+TEST_CASE("Bitwise Operators", "[BigInt]") {
+    BigInt a("123456789012345678901234567890");
+    BigInt b("-98765432109876543210");
+
+    REQUIRE((a << 100) == BigInt("156500072693749876333549759454926973536814597484617284976640"));
+    REQUIRE((a << 100) == a * BigInt(2).pow(100));
+    REQUIRE(((a << 100) >> 100) == a);
+    REQUIRE((a >> 70) == BigInt(104571967));
+    REQUIRE((b >> 3) == BigInt("-12345679013734567902"));  // Rounds toward negative infinity
+    REQUIRE((b >> 200) == BigInt(-1));
+    REQUIRE((a >> 200) == BigInt(0));
+
+    REQUIRE((a & b) == BigInt("123456788933793542183975452690"));
+    REQUIRE((a | b) == BigInt("-20213295392617428010"));
+    REQUIRE((a ^ b) == BigInt("-123456788954006837576592880700"));
+    REQUIRE(~a == BigInt("-123456789012345678901234567891"));
+    REQUIRE((b & BigInt(-1)) == b);
+    REQUIRE((a ^ a) == BigInt(0));
+
+    BigInt c = a;
+    c <<= 64;
+    c |= BigInt(5);
+    c >>= 1;
+    REQUIRE(c == (a << 63) + 2);
+
+    REQUIRE(a.bitLength() == 97);
+    REQUIRE(b.bitLength() == 67);
+    REQUIRE(BigInt(0).bitLength() == 0);
+    REQUIRE_FALSE(b.testBit(0));
+    REQUIRE(b.testBit(1));
+    REQUIRE_FALSE(b.testBit(3));
+    REQUIRE(b.testBit(100));
+    REQUIRE(a.testBit(96));
+    REQUIRE_FALSE(a.testBit(97));
+}
+
+//Scratch Arena:
+TEST_CASE("Scratch Arena", "[BigInt]") {
+    BigIntArena arena(64);
+    REQUIRE(arena.capacity() >= 64);
+
+    BigIntArena::Limb *first = arena.allocate(10);
+    BigIntArena::Marker marker = arena.mark();
+    BigIntArena::Limb *second = arena.allocate(20);
+    REQUIRE(second == first + 10);
+    arena.allocate(100000);  // Spills into a new block; earlier limbs stay put
+    REQUIRE(arena.used() == 100030);
+    arena.release(marker);
+    REQUIRE(arena.used() == 10);
+    REQUIRE(arena.allocate(20) == second);
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+
+    {
+        BigIntArena::Scope scope(arena);
+        scope.allocate(50);
+        REQUIRE(arena.used() == 50);
+    }
+    REQUIRE(arena.used() == 0);
+
+    // Kernels draw their temporaries from an installed arena and hand them all back
+    BigInt a = BigInt(3).pow(20000);
+    BigInt b = BigInt(7).pow(9000) + 1;
+    BigInt expectedProduct = a * b;
+    BigInt expectedQuotient = a / b;
+    {
+        BigIntArena::Use use(arena);
+        REQUIRE(&BigIntArena::current() == &arena);
+        REQUIRE(a * b == expectedProduct);
+        REQUIRE(a / b == expectedQuotient);
+        REQUIRE(arena.used() == 0);
+    }
+    REQUIRE(&BigIntArena::current() != &arena);
+}
+
+//Parallel Multiplication:
+TEST_CASE("Parallel Multiplication", "[BigInt]") {
+    // Karatsuba, Toom-3 and NTT sizes, squares and an unbalanced Toom split
+    BigInt karatsubaA = BigInt(3).pow(30000);
+    BigInt karatsubaB = BigInt(7).pow(17000) + 1;
+    BigInt toomA = BigInt(3).pow(100000);
+    BigInt toomB = BigInt(5).pow(60000) - 1;
+    BigInt toomC = BigInt(11).pow(30000);
+    BigInt nttA = BigInt(3).pow(400000);
+    BigInt nttB = BigInt(7).pow(250000) + 3;
+
+    BigInt expected[] = {karatsubaA * karatsubaB, karatsubaA.square(), toomA * toomB, toomA.square(),
+                         toomA * toomC, nttA * nttB};
+
+    BigIntThreadPool::start(4);
+    REQUIRE(BigIntThreadPool::running());
+    REQUIRE(BigIntThreadPool::size() == 4);
+    REQUIRE(karatsubaA * karatsubaB == expected[0]);
+    REQUIRE(karatsubaA.square() == expected[1]);
+    REQUIRE(toomA * toomB == expected[2]);
+    REQUIRE(toomA.square() == expected[3]);
+    REQUIRE(toomA * toomC == expected[4]);
+    REQUIRE(nttA * nttB == expected[5]);
+
+    // Exceptions thrown by tasks reach the thread that waits for them
+    BigIntThreadPool::TaskGroup tasks;
+    tasks.spawn([] { throw std::runtime_error("task failed"); });
+    REQUIRE_THROWS_AS(tasks.wait(), std::runtime_error);
+
+    BigIntThreadPool::stop();
+    REQUIRE_FALSE(BigIntThreadPool::running());
+    REQUIRE(karatsubaA * karatsubaB == expected[0]);
+}
+
+//Combinatorics:
+TEST_CASE("Combinatorics", "[BigInt]") {
+    BigInt running = 1;
+    for (unsigned n = 0; n <= 1200; ++n) {
+        if (n > 0) {
+            running *= n;
+        }
+        if (n <= 30 || n % 97 == 0 || n == 1200) {
+            REQUIRE(BigInt::factorial(n) == running);
+        }
+    }
+    REQUIRE(BigInt::factorial(12) == BigInt(factorial(12)));
+
+    REQUIRE(BigInt::binomial(100, 50) == BigInt("100891344545564193334812497256"));
+    REQUIRE(BigInt::binomial(1000000, 3) == BigInt("166666166667000000"));
+    REQUIRE(BigInt::binomial(1200, 600) == BigInt::factorial(1200) / BigInt::factorial(600).square());
+    REQUIRE(BigInt::binomial(5, 7) == BigInt(0));
+    REQUIRE(BigInt::binomial(7, 0) == BigInt(1));
+    REQUIRE(BigInt::binomial(7, 7) == BigInt(1));
+
+    BigInt previous = 0;
+    BigInt current = 1;
+    for (unsigned n = 1; n <= 1000; ++n) {
+        if (n <= 40 || n % 101 == 0 || n == 1000) {
+            REQUIRE(BigInt::fibonacci(n) == current);
+        }
+        BigInt next = previous + current;
+        previous = std::move(current);
+        current = std::move(next);
+    }
+    REQUIRE(BigInt::fibonacci(0) == BigInt(0));
+    REQUIRE(BigInt::fibonacci(100) == BigInt("354224848179261915075"));
+
+    REQUIRE(BigInt::primorial(1) == BigInt(1));
+    REQUIRE(BigInt::primorial(30) == BigInt(6469693230LL));
+    REQUIRE(BigInt::primorial(31) == BigInt(200560490130LL));
+}
+
+//Fixed Width Integers:
+TEST_CASE("Fixed Width Integers", "[BigInt]") {
+    using U256 = FixedBigInt<256>;
+    U256 a("12345678901234567890123456789012345678901234567890");
+    U256 b("98765432109876543210987654321");
+
+    // Arithmetic wraps around modulo 2^256
+    U256 cube = a * a * a;
+    REQUIRE(cube == U256("76986959188864762118429449939509105499063322281078661109186476824468937852872"));
+    REQUIRE(cube / b == U256("779492961699562758249128074515285267144531409359"));
+    REQUIRE(cube % b == U256("8252830907179144105301662633"));
+    REQUIRE(-a == U256("115792089237316195423570984996342228952035416775517107250445238329011895072046"));
+    REQUIRE(a - a == U256(0));
+    REQUIRE(U256(-1) == ~U256(0));
+    REQUIRE(U256(-1) + 1 == U256(0));
+    REQUIRE(U256(0) < U256(-1));
+
+    // The full product keeps every bit
+    FixedBigInt<512> wide = a.multiplyFull(b * 1000000007);
+    REQUIRE(static_cast<BigInt>(wide) ==
+            BigInt("1219326319905502131853375993170400850995884773399576284076759792712677351013467884468830"));
+
+    REQUIRE(static_cast<BigInt>(a) == BigInt("12345678901234567890123456789012345678901234567890"));
+    REQUIRE(U256(BigInt(-5)) == U256(-5));
+    REQUIRE(U256(BigInt(1) << 300) == U256(0));
+
+    REQUIRE((U256(1) << 255) >> 255 == U256(1));
+    REQUIRE((U256(1) << 256) == U256(0));
+    REQUIRE((a ^ b ^ b) == a);
+    REQUIRE((a & ~a) == U256(0));
+    REQUIRE(a.bitLength() == 164);
+    REQUIRE(U256(-1).testBit(255));
+    REQUIRE(a.toString() == "12345678901234567890123456789012345678901234567890");
+
+    std::ostringstream out;
+    out << b;
+    REQUIRE(out.str() == "98765432109876543210987654321");
+
+    REQUIRE_THROWS_AS(a / U256(0), std::runtime_error);
+}
+
+//Compile-Time Constants:
+TEST_CASE("Compile-Time Constants", "[BigInt]") {
+    using namespace bigint_literals;
+    using U256 = FixedBigInt<256>;
+
+    // Literals take the narrowest whole number of limbs that holds them
+    constexpr auto prime = 0xffffffff00000001_big;
+    constexpr auto order = 115792089237316195423570985008687907853269984665640564039457584007908834671663_big;
+    STATIC_REQUIRE(std::is_same<decltype(prime), const FixedBigInt<64>>::value);
+    STATIC_REQUIRE(std::is_same<decltype(order), const FixedBigInt<320>>::value);
+    STATIC_REQUIRE(1000000007_big * 3 == 3000000021_big);
+    STATIC_REQUIRE(0b1011_big == FixedBigInt<64>(11));
+    STATIC_REQUIRE(017_big == FixedBigInt<64>(15));
+    STATIC_REQUIRE(1'000'000_big == FixedBigInt<64>(1000000));
+
+    // A table of powers of ten, computed by the compiler
+    constexpr auto powers = [] {
+        std::array<U256, 78> table{};
+        table[0] = 1;
+        for (std::size_t i = 1; i < table.size(); ++i) {
+            table[i] = table[i - 1] * 10;
+        }
+        return table;
+    }();
+    STATIC_REQUIRE(powers[60] == U256(10).pow(60));
+    STATIC_REQUIRE(powers[77] / powers[76] == U256(10));
+    STATIC_REQUIRE(powers[60] % 7 == U256(1));
+    REQUIRE(powers[77].toString() == "1" + std::string(77, '0'));
+
+    // 2^512 mod p, for Montgomery-style constants
+    constexpr U256 modulus(order);
+    constexpr U256 r = U256((FixedBigInt<512>(1) << 256) % FixedBigInt<512>(modulus));
+    constexpr U256 r2 = U256(r.multiplyFull(r) % FixedBigInt<512>(modulus));
+    REQUIRE(static_cast<BigInt>(r2) == BigInt("18446752466076602529"));
+    REQUIRE(static_cast<BigInt>(prime) == BigInt("18446744069414584321"));
+    REQUIRE(FixedBigInt<64>(U256(-1)) == FixedBigInt<64>(-1));
+}
+
+//Binary Serialization:
+TEST_CASE("Binary Serialization", "[BigInt]") {
+    BigInt big = BigInt(3).pow(20000) * -1;
+    BigInt small("18446744073709551616");
+
+    // Header plus raw little-endian limbs
+    std::vector<unsigned char> record = serialize(small);
+    REQUIRE(record.size() == serializedSize(small));
+    REQUIRE(record == std::vector<unsigned char>{'B', 'I', 'G', 'N', 1, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0,
+                                                 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0});
+    REQUIRE(deserialize(record) == small);
+    REQUIRE(deserialize(serialize(big)) == big);
+    REQUIRE(deserialize(serialize(BigInt(0))) == BigInt(0));
+    REQUIRE(serializedSize(BigInt(0)) == 16);
+
+    // Several records follow each other in a stream
+    std::stringstream stream;
+    serialize(big, stream);
+    serialize(small, stream);
+    serialize(BigInt(-7), stream);
+    REQUIRE(deserialize(stream) == big);
+    REQUIRE(deserialize(stream) == small);
+    REQUIRE(deserialize(stream) == BigInt(-7));
+    REQUIRE_THROWS_AS(deserialize(stream), std::invalid_argument);
+
+    // A mapped file is read in place
+    std::string path = "big_int_test_serialization.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        serialize(big, out);
+        serialize(small, out);
+    }
+    REQUIRE(deserialize(path) == big);
+    {
+        BigIntMapping mapping(path);
+        BigIntView first = mapping.view();
+        BigIntView second = mapping.view(serializedSize(first));
+        REQUIRE(first == big);
+        REQUIRE(second == small);
+        REQUIRE(first < second);
+        REQUIRE(first.isNegative());
+        REQUIRE(first.bitLength() == (big * -1).bitLength());
+        REQUIRE(second.testBit(64));
+        REQUIRE(first.toString() == big.toString());
+        REQUIRE(first.toBigInt() == big);
+        REQUIRE_THROWS_AS(mapping.view(4), std::invalid_argument);
+    }
+    serialize(small, path);
+    REQUIRE(deserialize(path) == small);
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(deserialize(path), std::runtime_error);
+
+    // Malformed records
+    std::vector<unsigned char> bad = record;
+    bad[0] = 'X';
+    REQUIRE_THROWS_AS(deserialize(bad), std::invalid_argument);
+    bad = record;
+    bad[4] = 2;
+    REQUIRE_THROWS_AS(deserialize(bad), std::invalid_argument);
+    bad = record;
+    bad.pop_back();
+    REQUIRE_THROWS_AS(deserialize(bad), std::invalid_argument);
+    bad = record;
+    bad[24] = 0;
+    REQUIRE_THROWS_AS(deserialize(bad), std::invalid_argument);
+    REQUIRE_THROWS_AS(deserialize(record.data(), 10), std::invalid_argument);
+}
+
+//Streaming Input:
+TEST_CASE("Streaming Input", "[BigInt]") {
+    // Long enough for several chunks to be converted and merged
+    BigInt big = BigInt(3).pow(500000) * -1;
+    std::string text = big.toString();
+    std::istringstream input("  " + text + "\n000123 -0 42");
+    BigInt a, b, c, d;
+    input >> a >> b >> c >> d;
+    REQUIRE(a == big);
+    REQUIRE(b == BigInt(123));
+    REQUIRE(c == BigInt(0));
+    REQUIRE(d == BigInt(42));
+    REQUIRE(input.eof());
+
+    // Leading zeros filling whole chunks
+    std::istringstream zeros(std::string(200000, '0') + "7 ");
+    REQUIRE(BigInt::read(zeros, a));
+    REQUIRE(a == BigInt(7));
+
+    // Digit cap
+    std::istringstream capped(text);
+    REQUIRE_THROWS_AS(BigInt::read(capped, a, 1000), std::invalid_argument);
+    std::istringstream exact("12345");
+    BigInt::read(exact, a, 5);
+    REQUIRE(a == BigInt(12345));
+
+    // Malformed input
+    std::istringstream letters("12a4");
+    REQUIRE_THROWS_AS(letters >> a, std::invalid_argument);
+    std::istringstream sign("- 5");
+    REQUIRE_THROWS_AS(sign >> a, std::invalid_argument);
+
+    // Stream exceptions do not replace the documented ones
+    std::istringstream throwing("12x3");
+    throwing.exceptions(std::ios::failbit);
+    REQUIRE_THROWS_AS(throwing >> a, std::invalid_argument);
+    REQUIRE(throwing.fail());
+    std::istringstream throwingCap("123456");
+    throwingCap.exceptions(std::ios::failbit);
+    REQUIRE_THROWS_AS(BigInt::read(throwingCap, a, 5), std::invalid_argument);
+    REQUIRE(throwingCap.fail());
+
+    // Nothing to read leaves the value alone
+    std::istringstream empty("   ");
+    a = 5;
+    empty >> a;
+    REQUIRE(empty.fail());
+    REQUIRE(a == BigInt(5));
+}